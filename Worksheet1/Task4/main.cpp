@@ -51,5 +51,15 @@ int main() {
     s.setChar(1, 'E');
     s.print();
 
+    // Test with a my_string longer than my_string::inline_capacity (shared heap buffer)
+    my_string l("Hello, Reference Counted Template");
+    l.print();
+
+    {
+        my_string m = l;  // Copy constructor
+        m.print();
+        l.print();
+    }  // m goes out of scope
+
     return 0;
 }
@@ -1,52 +1,105 @@
 // my_string.cpp
 #include "my_string.hpp"
+#include <new>
+
+// Helper function to copy another string's storage into this (uninitialized) object
+void my_string::copy_from(const my_string& s) {
+    is_small = s.is_small;
+    if (is_small) {
+        memcpy(small, s.small, sizeof(small));               // Short string: copy the characters
+    } else {
+        new (&str_ref) ReferenceCounted<char>(s.str_ref);    // Long string: share the buffer
+    }
+}
+
+// Helper function to destroy the active storage
+void my_string::destroy() {
+    if (!is_small) {
+        str_ref.~ReferenceCounted<char>();  // Drop this reference to the shared buffer
+    }
+}
+
+// Helper function to get the characters (nullptr for an empty my_string)
+char* my_string::data() {
+    return is_small ? small : str_ref.get();
+}
+
+const char* my_string::data() const {
+    return is_small ? small : str_ref.get();
+}
 
 // Default constructor
-my_string::my_string() : str_ref(nullptr) {}
+my_string::my_string() : is_small(false) {
+    new (&str_ref) ReferenceCounted<char>(nullptr);  // Empty, nothing allocated
+}
 
 // Parameterized constructor
 my_string::my_string(const char* s) {
+    size_t length = s ? strlen(s) : 0;
+    if (s && length <= inline_capacity) {
+        memcpy(small, s, length + 1);  // Short string: store it inline, no allocation
+        is_small = true;
+        return;
+    }
+    char* str = nullptr;
     if (s) {
-        char* str = new char[strlen(s) + 1];  // Allocate memory for the string
-        strcpy(str, s);                       // Copy the input string
-        str_ref = ReferenceCounted<char>(str);  // Initialize reference counted object
+        str = new char[length + 1];  // Allocate memory for the string
+        memcpy(str, s, length + 1);  // Copy the input string
     }
+    new (&str_ref) ReferenceCounted<char>(str);  // Initialize reference counted object
+    is_small = false;
 }
 
 // Copy constructor
-my_string::my_string(const my_string& s) : str_ref(s.str_ref) {}
+my_string::my_string(const my_string& s) {
+    copy_from(s);
+}
 
 // Assignment operator
 my_string& my_string::operator=(const my_string& s) {
     if (this != &s) {
-        str_ref = s.str_ref;  // Copy the reference counted object
+        if (!is_small && !s.is_small) {
+            str_ref = s.str_ref;  // Copy the reference counted object
+        } else {
+            destroy();
+            copy_from(s);
+        }
     }
     return *this;
 }
 
 // Destructor
 my_string::~my_string() {
-    // No manual memory management needed, handled by ReferenceCounted
+    destroy();
 }
 
 // Get character at a specific index
 char my_string::getChar(const int& i) const {
-    if (str_ref.get() && i >= 0 && i < strlen(str_ref.get())) {
-        return str_ref.get()[i];
+    const char* str = data();
+    if (str && i >= 0 && i < strlen(str)) {
+        return str[i];
     }
     return '\0';  // Return null character if index is out of bounds
 }
 
 // Set a character at a specific index
 void my_string::setChar(const int& i, const char& c) {
-    if (str_ref.get() && i >= 0 && i < strlen(str_ref.get())) {
-        str_ref.get()[i] = c;
+    char* str = data();
+    if (str && i >= 0 && i < strlen(str)) {
+        str[i] = c;
     }
 }
 
-// Print the string along with the reference count
+// Check whether the string is stored inline (no heap allocation)
+bool my_string::isInline() const {
+    return is_small;
+}
+
+// Print the string along with the reference count (an inline string has exactly one owner)
 void my_string::print() const {
-    if (str_ref.get()) {
+    if (is_small) {
+        std::cout << small << " [1]" << std::endl;
+    } else if (str_ref.get()) {
         std::cout << str_ref.get() << " [" << str_ref.get_ref_count() << "]" << std::endl;
     } else {
         std::cout << "Empty string" << std::endl;
@@ -6,9 +6,30 @@
 #include <cstring>
 #include "ReferenceCounted.hpp"
 
+// Strings of up to inline_capacity characters are stored inside the object
+// (small-string optimization): constructing or copying one needs no heap
+// allocation and no reference count, and each copy owns its own characters.
+// Longer strings share one heap buffer through ReferenceCounted, as before.
 class my_string {
+public:
+    static const std::size_t inline_capacity = 22;  // Longest string stored inline
+
 private:
-    ReferenceCounted<char> str_ref;  // Use ReferenceCounted to manage char*
+    union {
+        ReferenceCounted<char> str_ref;     // Long strings: shared, reference-counted buffer
+        char small[inline_capacity + 1];    // Short strings: the characters and their '\0'
+    };
+    bool is_small;                          // Which member of the union is active
+
+    // Helper function to copy another string's storage into this (uninitialized) object
+    void copy_from(const my_string& s);
+
+    // Helper function to destroy the active storage
+    void destroy();
+
+    // Helper function to get the characters (nullptr for an empty my_string)
+    char* data();
+    const char* data() const;
 
 public:
     // Default constructor
@@ -32,6 +53,9 @@ public:
     // Set a character at a specific index
     void setChar(const int& i, const char& c);
 
+    // Check whether the string is stored inline (no heap allocation)
+    bool isInline() const;
+
     // Print the string along with the reference count
     void print() const;
 };
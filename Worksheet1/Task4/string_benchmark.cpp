@@ -0,0 +1,105 @@
+// string_benchmark.cpp
+#include "my_string.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Construction and copy cost of short keys (stored inline) versus long strings
+// (heap buffer + reference count), with std::string as a reference point.
+
+const int iterations = 200000;
+
+// Time func over all iterations and return the best of 5 runs in nanoseconds per iteration
+template <typename Func>
+double time_ns(Func func) {
+    double best = 0;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        if (run == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+// Construct a my_string from each key in turn
+double construct_my_string(const std::vector<const char*>& keys) {
+    return time_ns([&] {
+        for (int i = 0; i < iterations; ++i) {
+            my_string s(keys[i % keys.size()]);
+            volatile char c = s.getChar(0);  // Keep the string alive
+            (void)c;
+        }
+    });
+}
+
+// Copy one my_string repeatedly
+double copy_my_string(const char* key) {
+    my_string original(key);
+    return time_ns([&] {
+        for (int i = 0; i < iterations; ++i) {
+            my_string copy = original;
+            volatile char c = copy.getChar(0);
+            (void)c;
+        }
+    });
+}
+
+double construct_std_string(const std::vector<const char*>& keys) {
+    return time_ns([&] {
+        for (int i = 0; i < iterations; ++i) {
+            std::string s(keys[i % keys.size()]);
+            volatile char c = s[0];
+            (void)c;
+        }
+    });
+}
+
+double copy_std_string(const char* key) {
+    std::string original(key);
+    return time_ns([&] {
+        for (int i = 0; i < iterations; ++i) {
+            std::string copy = original;
+            volatile char c = copy[0];
+            (void)c;
+        }
+    });
+}
+
+int main() {
+    std::vector<const char*> short_keys = {"id", "name", "user_id", "created_at", "price", "session_token", "x", "country_code"};
+    std::vector<const char*> long_keys = {"a key that is longer than twenty-two bytes",
+                                          "another long key that needs a heap buffer",
+                                          "customer.shipping_address.postal_code"};
+
+    // ReferenceCounted logs every count change; silence std::cout so the long-string
+    // timings measure the allocations and counts rather than console output.
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    double short_construct = construct_my_string(short_keys);
+    double long_construct = construct_my_string(long_keys);
+    double short_copy = copy_my_string(short_keys[5]);
+    double long_copy = copy_my_string(long_keys[0]);
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    double std_short_construct = construct_std_string(short_keys);
+    double std_long_construct = construct_std_string(long_keys);
+    double std_short_copy = copy_std_string(short_keys[5]);
+    double std_long_copy = copy_std_string(long_keys[0]);
+
+    std::cout << "ns per operation (best of 5 x " << iterations << ")\n";
+    std::cout << "my_string construct, short keys (inline): " << short_construct << "\n";
+    std::cout << "my_string construct, long keys (heap):    " << long_construct << "\n";
+    std::cout << "my_string copy, short key (inline):       " << short_copy << "\n";
+    std::cout << "my_string copy, long key (shared):        " << long_copy << "\n";
+    std::cout << "std::string construct, short keys:        " << std_short_construct << "\n";
+    std::cout << "std::string construct, long keys:         " << std_long_construct << "\n";
+    std::cout << "std::string copy, short key:              " << std_short_copy << "\n";
+    std::cout << "std::string copy, long key:               " << std_long_copy << "\n";
+    std::cout << "sizeof(my_string): " << sizeof(my_string) << " bytes, inline capacity "
+              << my_string::inline_capacity << " characters\n";
+    return 0;
+}
@@ -1,12 +1,66 @@
 // BumpAllocatorTests.cpp
 #include "BumpAllocator.hpp"
+#include "../Task3/BumpAllocatorAtomic.hpp"
+#include "../Task3/ThreadCachedBumpAllocator.hpp"
+#include "../Task3/ChainedBumpAllocator.hpp"
+#include "../Task3/BumpAllocatorUpwards.hpp"
+#include "../Task3/BumpAllocatorDownwards.hpp"
+#include "../Task3/ScopedRollback.hpp"
+#include "../Task3/DoubleEndedBumpAllocator.hpp"
+#include "../Task3/BumpMemoryResource.hpp"
+#include "../Task3/SizeClassPool.hpp"
+#include "../Task3/MmapHeap.hpp"
+#include "../Task3/AllocatorStats.hpp"
+#include "../Task3/ArenaBuffer.hpp"
+#include "../Task3/ArenaSnapshot.hpp"
+#include "../Task3/SharedBumpAllocator.hpp"
+#include "../Task3/EpochArenaRing.hpp"
+#include "../Task3/Benchmark.hpp"
+#include "../Task3/BenchmarkResults.hpp"
+#include "../Task3/AllocationTrace.hpp"
+#include "../Task3/WorkloadGenerator.hpp"
 #include "simpletest/simpletest.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
 
 using namespace std;
 
 char const *groups[] = {
     "BumpAllocatorTests",
+    "BumpAllocatorAtomicTests",
+    "ThreadCachedBumpAllocatorTests",
+    "ChainedBumpAllocatorTests",
+    "ScopedRollbackTests",
+    "DoubleEndedBumpAllocatorTests",
+    "BumpMemoryResourceTests",
+    "SizeClassPoolTests",
+    "MmapHeapTests",
+    "TypedConstructionTests",
+    "AllocationStatsTests",
+    "BasicBumpAllocatorTests",
+    "AllocBatchTests",
+    "OverAlignmentTests",
+    "ResizeLastTests",
+    "ArenaSnapshotTests",
+    "SharedBumpAllocatorTests",
+    "EpochArenaRingTests",
+    "BenchmarkHarnessTests",
+    "AllocationTraceTests",
+    "WorkloadGeneratorTests",
+    "LatencyHistogramTests",
+    "BenchmarkResultsTests",
 };
 
 // Test: Single allocation and deallocation
@@ -105,6 +159,1271 @@ DEFINE_TEST_G(SmallHeapMemoryExceeded, BumpAllocatorTests) {
     TEST_MESSAGE(int_ptr == nullptr, "Allocation succeeded unexpectedly on small heap exceeding available memory!");
 }
 
+// Test: Lock-free allocator keeps the same alignment, bounds and reset behaviour
+DEFINE_TEST_G(AtomicAlignmentAndReset, BumpAllocatorAtomicTests) {
+    BumpAllocatorAtomic allocator(64);
+
+    char* char_ptr = allocator.alloc<char>(1);
+    double* double_ptr = allocator.alloc<double>(1);
+    TEST_MESSAGE(char_ptr != nullptr && double_ptr != nullptr, "Lock-free allocation failed!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(double_ptr) % alignof(double) == 0, "Lock-free allocation is misaligned!");
+
+    TEST_MESSAGE(allocator.alloc<int>(100) == nullptr, "Lock-free allocation succeeded unexpectedly when exceeding memory limit!");
+
+    allocator.dealloc();
+    TEST_MESSAGE(allocator.remaining_memory() < 64, "Lock-free allocator reset before all allocations were freed!");
+    allocator.dealloc();
+    TEST_MESSAGE(allocator.remaining_memory() == 64, "Lock-free allocator did not reset after all allocations were freed!");
+}
+
+// Test: Concurrent allocations never hand out overlapping memory
+DEFINE_TEST_G(AtomicConcurrentAllocations, BumpAllocatorAtomicTests) {
+    const int thread_count = 4;
+    const int allocations_per_thread = 1000;
+    BumpAllocatorAtomic allocator(thread_count * allocations_per_thread * sizeof(int));
+
+    std::vector<std::vector<int*>> results(thread_count);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&allocator, &results, t] {
+            for (int i = 0; i < allocations_per_thread; ++i) {
+                results[t].push_back(allocator.alloc<int>(1));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::set<int*> unique;
+    for (auto& ptrs : results) {
+        for (int* ptr : ptrs) {
+            TEST_MESSAGE(ptr != nullptr, "Concurrent allocation failed on an exactly sized heap!");
+            unique.insert(ptr);
+        }
+    }
+    TEST_MESSAGE(unique.size() == thread_count * allocations_per_thread, "Concurrent allocations overlapped!");
+    TEST_MESSAGE(allocator.remaining_memory() == 0, "Remaining memory not zero after filling the heap concurrently.");
+}
+
+// Test: Thread caches take chunks from the parent and reset() returns them all
+DEFINE_TEST_G(ThreadCachedChunksReturnedOnReset, ThreadCachedBumpAllocatorTests) {
+    BumpAllocatorAtomic parent(64 * 1024);
+    ThreadCachedBumpAllocator<BumpAllocatorAtomic> allocator(parent, 1024);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&allocator] {
+            for (int i = 0; i < 500; ++i) {
+                allocator.alloc<int>(1);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    TEST_MESSAGE(allocator.chunk_count() >= 4, "Each thread should have taken at least one chunk from the parent!");
+    TEST_MESSAGE(parent.remaining_memory() < 64 * 1024, "Parent memory not consumed by thread chunks.");
+
+    allocator.reset();
+    TEST_MESSAGE(allocator.chunk_count() == 0, "Chunks still held after reset!");
+    TEST_MESSAGE(parent.remaining_memory() == 64 * 1024, "Parent did not reset after all chunks were returned!");
+}
+
+// Test: Allocations larger than a chunk get a dedicated chunk from the parent
+DEFINE_TEST_G(ThreadCachedLargeAllocation, ThreadCachedBumpAllocatorTests) {
+    BumpAllocatorAtomic parent(8 * 1024);
+    ThreadCachedBumpAllocator<BumpAllocatorAtomic> allocator(parent, 256);
+
+    int* small_ptr = allocator.alloc<int>(1);
+    double* large_ptr = allocator.alloc<double>(100);
+    int* next_small_ptr = allocator.alloc<int>(1);
+    TEST_MESSAGE(small_ptr != nullptr && large_ptr != nullptr && next_small_ptr != nullptr, "Thread-cached allocation failed!");
+    TEST_MESSAGE(next_small_ptr == small_ptr + 1, "Large allocation should not replace the thread's current chunk!");
+
+    TEST_MESSAGE(allocator.alloc<double>(2000) == nullptr, "Allocation succeeded unexpectedly when exceeding parent memory!");
+}
+
+// Test: Chained allocator grows instead of returning nullptr (compare AllocationExceedsMemory)
+DEFINE_TEST_G(ChainedAllocationGrowsHeap, ChainedBumpAllocatorTests) {
+    GrowthPolicy policy;
+    policy.initial_block_size = 50;
+    policy.growth_factor = 2.0;
+    policy.max_block_size = 400;
+    ChainedBumpAllocator allocator(policy);
+
+    int* int_ptr = allocator.alloc<int>(15); // Requires 60 bytes, exceeds the 50-byte first block
+    TEST_MESSAGE(int_ptr != nullptr, "Chained allocator failed to grow for an oversized request!");
+    TEST_MESSAGE(allocator.block_count() == 2, "Chained allocator should have linked on a second block.");
+
+    double* big_ptr = allocator.alloc<double>(100); // 800 bytes, larger than the block cap
+    TEST_MESSAGE(big_ptr != nullptr, "Chained allocator failed to fit a request larger than the block cap!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(big_ptr) % alignof(double) == 0, "Chained allocation is misaligned!");
+}
+
+// Test: Reset keeps one block for the whole round so the next round needs no new blocks
+DEFINE_TEST_G(ChainedResetKeepsOneBlock, ChainedBumpAllocatorTests) {
+    GrowthPolicy policy;
+    policy.initial_block_size = 64;
+    policy.growth_factor = 2.0;
+    policy.max_block_size = 1024;
+    ChainedBumpAllocator allocator(policy);
+
+    for (int i = 0; i < 100; ++i) {
+        allocator.alloc<int>(4);
+    }
+    TEST_MESSAGE(allocator.block_count() > 1, "Chained allocator did not grow under load!");
+    for (int i = 0; i < 100; ++i) {
+        allocator.dealloc();
+    }
+    TEST_MESSAGE(allocator.block_count() == 1, "Reset should keep exactly one block!");
+    TEST_MESSAGE(allocator.remaining_memory() == 100 * 4 * sizeof(int), "Reset should keep a block the size of the round!");
+
+    for (int i = 0; i < 50; ++i) {
+        allocator.alloc<int>(4);
+    }
+    TEST_MESSAGE(allocator.block_count() == 1, "Steady-state round should fit in the kept block!");
+}
+
+// Test: A round larger than max_block_size stops linking blocks after the first reset
+DEFINE_TEST_G(ChainedResetCoversRoundAboveCap, ChainedBumpAllocatorTests) {
+    GrowthPolicy policy;
+    policy.initial_block_size = 64;
+    policy.growth_factor = 2.0;
+    policy.max_block_size = 256;
+    ChainedBumpAllocator allocator(policy);
+
+    std::size_t capacity = 0;
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            allocator.alloc<char>(i % 2 == 0 ? 3 : 1); // Odd sizes so alignment padding differs by block
+            allocator.alloc<double>(2);
+        }
+        if (round == 0) {
+            TEST_MESSAGE(allocator.block_count() > 1, "First round should link several capped blocks!");
+        } else {
+            TEST_MESSAGE(allocator.block_count() == 1 && allocator.capacity() == capacity, "Round after a reset linked new blocks!");
+        }
+        for (int i = 0; i < 200; ++i) {
+            allocator.dealloc();
+        }
+        TEST_MESSAGE(allocator.block_count() == 1, "Reset should keep exactly one block!");
+        capacity = round == 0 ? allocator.capacity() : capacity;
+    }
+    TEST_MESSAGE(capacity > policy.max_block_size, "Kept block should cover the round, above the cap!");
+}
+
+// Test: Rolling back to a marker releases only what was allocated after it
+DEFINE_TEST_G(RollbackToMarker, ScopedRollbackTests) {
+    BumpAllocatorUpwards allocator(100);
+
+    int* keep_ptr = allocator.alloc<int>(5); // 20 bytes kept
+    BumpAllocatorUpwards::Marker marker = allocator.mark();
+    allocator.alloc<int>(10);
+    TEST_MESSAGE(allocator.remaining_memory() == 40, "Remaining memory not as expected before rollback.");
+
+    allocator.rollback(marker);
+    TEST_MESSAGE(allocator.remaining_memory() == 80, "Rollback did not restore the marked position!");
+
+    int* reused_ptr = allocator.alloc<int>(1);
+    TEST_MESSAGE(reused_ptr == keep_ptr + 5, "Memory after the marker was not reused!");
+}
+
+// Test: Nested scope guards roll back in order for both directions
+DEFINE_TEST_G(NestedScopedRollback, ScopedRollbackTests) {
+    BumpAllocatorUpwards up(100);
+    BumpAllocatorDownwards down(100);
+
+    up.alloc<int>(1);
+    down.alloc<int>(1);
+    {
+        ScopedRollback<BumpAllocatorUpwards> outer_up(up);
+        ScopedRollback<BumpAllocatorDownwards> outer_down(down);
+        up.alloc<int>(5);
+        down.alloc<int>(5);
+        {
+            ScopedRollback<BumpAllocatorUpwards> inner_up(up);
+            ScopedRollback<BumpAllocatorDownwards> inner_down(down);
+            up.alloc<int>(10);
+            down.alloc<int>(10);
+        }
+        TEST_MESSAGE(up.remaining_memory() == 76 && down.remaining_memory() == 76, "Inner scope did not roll back!");
+    }
+    TEST_MESSAGE(up.remaining_memory() == 96 && down.remaining_memory() == 96, "Outer scope did not roll back!");
+
+    // The allocation made before the scopes is still the only active one
+    up.dealloc();
+    down.dealloc();
+    TEST_MESSAGE(up.remaining_memory() == 100 && down.remaining_memory() == 100, "Allocators did not reset after the remaining allocation was freed!");
+}
+
+// Test: Both sides share one buffer and fail only when they would collide
+DEFINE_TEST_G(DoubleEndedCollision, DoubleEndedBumpAllocatorTests) {
+    DoubleEndedBumpAllocator allocator(64);
+
+    int* low_ptr = allocator.alloc_low<int>(8);     // 32 bytes from the bottom
+    int* high_ptr = allocator.alloc_high<int>(4);   // 16 bytes from the top
+    TEST_MESSAGE(low_ptr != nullptr && high_ptr != nullptr, "Double-ended allocation failed!");
+    TEST_MESSAGE(high_ptr > low_ptr + 7, "High side allocation overlaps the low side!");
+    TEST_MESSAGE(allocator.remaining_memory() == 16, "Remaining memory not as expected between the two sides.");
+
+    TEST_MESSAGE(allocator.alloc_low<int>(5) == nullptr, "Low side ran into the high side!");
+    TEST_MESSAGE(allocator.alloc_high<int>(5) == nullptr, "High side ran into the low side!");
+    TEST_MESSAGE(allocator.alloc_high<int>(4) != nullptr, "Exact fit between the two sides failed!");
+    TEST_MESSAGE(allocator.remaining_memory() == 0, "Remaining memory not zero after the sides met.");
+}
+
+// Test: Each side resets independently
+DEFINE_TEST_G(DoubleEndedIndependentReset, DoubleEndedBumpAllocatorTests) {
+    DoubleEndedBumpAllocator allocator(100);
+
+    allocator.alloc_low<double>(2);
+    allocator.alloc_high<char>(10);
+    allocator.alloc_high<char>(10);
+
+    allocator.dealloc_high();
+    TEST_MESSAGE(allocator.high_used() == 20, "High side reset before all its allocations were freed!");
+    allocator.dealloc_high();
+    TEST_MESSAGE(allocator.high_used() == 0, "High side did not reset!");
+    TEST_MESSAGE(allocator.low_used() == 16, "Resetting the high side disturbed the low side!");
+
+    allocator.dealloc_low();
+    TEST_MESSAGE(allocator.remaining_memory() == 100, "Allocator not empty after both sides reset.");
+}
+
+// Test: pmr containers allocate from the arena and reset it when destroyed
+DEFINE_TEST_G(PmrVectorUsesArena, BumpMemoryResourceTests) {
+    BumpAllocator allocator(4096, false);
+    BumpMemoryResource<BumpAllocator> resource(allocator);
+    {
+        std::pmr::vector<int> values(&resource);
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        TEST_MESSAGE(allocator.remaining_memory() < 4096 - 100 * sizeof(int), "pmr vector did not allocate from the arena!");
+        TEST_MESSAGE(values[99] == 99, "pmr vector contents corrupted!");
+    }
+    TEST_MESSAGE(allocator.remaining_memory() == 4096, "Arena did not reset after the pmr vector was destroyed!");
+}
+
+// Test: Exhausted arena surfaces as std::bad_alloc rather than nullptr
+DEFINE_TEST_G(PmrExhaustionThrows, BumpMemoryResourceTests) {
+    BumpAllocator allocator(64, false);
+    BumpMemoryResource<BumpAllocator> resource(allocator);
+
+    bool threw = false;
+    try {
+        std::pmr::vector<int> values(100, 0, &resource);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    TEST_MESSAGE(threw, "Exhausted arena did not throw std::bad_alloc!");
+}
+
+// Test: STL allocator adapter works with allocator-template containers
+DEFINE_TEST_G(StlAdapterVector, BumpMemoryResourceTests) {
+    BumpAllocator allocator(4096, false);
+    {
+        std::vector<double, BumpStlAllocator<double, BumpAllocator>> values{BumpStlAllocator<double, BumpAllocator>(allocator)};
+        values.assign(50, 1.5);
+        TEST_MESSAGE(allocator.remaining_memory() <= 4096 - 50 * sizeof(double), "STL adapter did not allocate from the arena!");
+        TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(double) == 0, "STL adapter allocation is misaligned!");
+    }
+    TEST_MESSAGE(allocator.remaining_memory() == 4096, "Arena did not reset after the vector was destroyed!");
+
+    // A count whose byte size wraps must throw instead of allocating a few bytes
+    BumpStlAllocator<double, BumpAllocator> adapter(allocator);
+    bool threw = false;
+    try {
+        adapter.allocate(adapter.max_size() + 1);
+    } catch (const std::bad_array_new_length&) {
+        threw = true;
+    }
+    TEST_MESSAGE(threw && allocator.remaining_memory() == 4096, "Overflowing count did not throw std::bad_array_new_length!");
+}
+
+// Test: Freed blocks are reused by the next request of the same size class
+DEFINE_TEST_G(PoolReusesFreedBlocks, SizeClassPoolTests) {
+    BumpAllocator allocator(64 * 1024, false);
+    SizeClassPool<BumpAllocator> pool(allocator, 1024);
+
+    void* first = pool.alloc(24);   // 32-byte class
+    void* second = pool.alloc(24);
+    TEST_MESSAGE(first != nullptr && second != nullptr && first != second, "Pool allocation failed!");
+
+    std::size_t remaining = allocator.remaining_memory();
+    pool.free(first, 24);
+    void* reused = pool.alloc(30);  // Same 32-byte class
+    TEST_MESSAGE(reused == first, "Freed block was not reused by the same size class!");
+    TEST_MESSAGE(allocator.remaining_memory() == remaining, "Reuse should not touch the arena!");
+
+    void* other_class = pool.alloc(100); // 128-byte class
+    TEST_MESSAGE(other_class != first && other_class != second, "Size classes share blocks!");
+    TEST_MESSAGE(SizeClassPool<BumpAllocator>::class_size(100) == 128, "Size class rounding not as expected.");
+}
+
+// Test: Reset returns every slab and large block to the arena
+DEFINE_TEST_G(PoolResetReturnsSlabs, SizeClassPoolTests) {
+    BumpAllocator allocator(64 * 1024, false);
+    SizeClassPool<BumpAllocator> pool(allocator, 1024);
+
+    for (int i = 0; i < 100; ++i) {
+        pool.alloc<int>(4);
+    }
+    void* large = pool.alloc(8000); // Above the largest class, served directly by the arena
+    TEST_MESSAGE(large != nullptr, "Large pool allocation failed!");
+
+    pool.reset();
+    TEST_MESSAGE(allocator.remaining_memory() == 64 * 1024, "Arena did not reset after the pool was reset!");
+}
+
+// Test: Allocators run on an mmap-backed heap rounded up to whole pages
+DEFINE_TEST_G(MmapBackedAllocators, MmapHeapTests) {
+    MmapHeap heap(1000);
+    std::size_t heap_size = heap.size();
+    TEST_MESSAGE(heap.data() != nullptr && heap_size >= 1000, "mmap heap was not created!");
+
+    BumpAllocatorDownwards allocator(std::move(heap));
+    TEST_MESSAGE(allocator.remaining_memory() == heap_size, "Allocator does not see the whole mapped heap!");
+
+    int* int_ptr = allocator.alloc<int>(10);
+    TEST_MESSAGE(int_ptr != nullptr, "Allocation from the mapped heap failed!");
+    int_ptr[9] = 42;
+    TEST_MESSAGE(int_ptr[9] == 42, "Mapped heap is not writable!");
+}
+
+// Test: Huge pages and prefaulting fall back gracefully when unavailable
+DEFINE_TEST_G(MmapHugePageFallback, MmapHeapTests) {
+    MmapOptions options;
+    options.huge_pages = true;
+    options.prefault = true;
+    MmapHeap heap(4096, options);
+
+    TEST_MESSAGE(heap.data() != nullptr, "Huge page request did not fall back to normal pages!");
+    TEST_MESSAGE(heap.size() % MmapHeap::huge_page_size == 0, "Huge page heap not rounded to the huge page size.");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(heap.data()) % MmapHeap::huge_page_size == 0, "Huge page heap is not huge-page aligned.");
+
+    BumpAllocatorUpwards allocator(std::move(heap));
+    TEST_MESSAGE(allocator.alloc<double>(1000) != nullptr, "Allocation from the huge page heap failed!");
+}
+
+// Helper type that counts how many instances have been destroyed
+struct DestructionCounter {
+    static int destroyed;
+    int value;
+    DestructionCounter(int v) : value(v) {}
+    ~DestructionCounter() { destroyed++; }
+};
+int DestructionCounter::destroyed = 0;
+
+// Test: Objects built with create() are constructed and destroyed on reset
+DEFINE_TEST_G(CreateRunsDestructorsOnReset, TypedConstructionTests) {
+    DestructionCounter::destroyed = 0;
+    BumpAllocatorUpwards allocator(1024);
+
+    DestructionCounter* single = allocator.create<DestructionCounter>(7);
+    DestructionCounter* array = allocator.create_array<DestructionCounter>(3, 9);
+    TEST_MESSAGE(single != nullptr && single->value == 7, "create() did not construct the object!");
+    TEST_MESSAGE(array != nullptr && array[2].value == 9, "create_array() did not construct every object!");
+
+    allocator.dealloc();
+    TEST_MESSAGE(DestructionCounter::destroyed == 0, "Destructors ran before the allocator reset!");
+    allocator.dealloc();
+    TEST_MESSAGE(DestructionCounter::destroyed == 4, "Destructors did not run on reset!");
+}
+
+// Test: Trivially destructible types get no destructor entry
+DEFINE_TEST_G(CreateTrivialTypeHasNoOverhead, TypedConstructionTests) {
+    BumpAllocatorDownwards allocator(64);
+
+    int* values = allocator.create_array<int>(4, 5);
+    TEST_MESSAGE(values != nullptr && values[3] == 5, "create_array() did not construct ints!");
+    TEST_MESSAGE(allocator.remaining_memory() == 64 - 4 * sizeof(int), "Trivially destructible type used extra arena memory!");
+}
+
+// Test: Rolling back destroys only the objects created after the marker
+DEFINE_TEST_G(RollbackRunsDestructors, TypedConstructionTests) {
+    DestructionCounter::destroyed = 0;
+    BumpAllocatorDownwards allocator(1024);
+
+    allocator.create<DestructionCounter>(1);
+    {
+        ScopedRollback<BumpAllocatorDownwards> frame(allocator);
+        allocator.create_array<DestructionCounter>(2, 2);
+    }
+    TEST_MESSAGE(DestructionCounter::destroyed == 2, "Rollback did not destroy the scoped objects!");
+}
+
+// Helper type whose constructor throws for negative values
+struct ThrowingCounter {
+    ThrowingCounter(int v) {
+        if (v < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+    ~ThrowingCounter() { DestructionCounter::destroyed++; }
+};
+
+// Test: A constructor that throws gives its space back and leaves earlier objects alive
+DEFINE_TEST_G(CreateThrowReclaimsSpace, TypedConstructionTests) {
+    DestructionCounter::destroyed = 0;
+    BumpAllocatorUpwards allocator(1024);
+    allocator.create<DestructionCounter>(1);
+    std::size_t remaining = allocator.remaining_memory();
+
+    bool threw = false;
+    try {
+        allocator.create<ThrowingCounter>(-1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    TEST_MESSAGE(threw && allocator.remaining_memory() == remaining, "Failed create() kept its space!");
+    TEST_MESSAGE(DestructionCounter::destroyed == 0, "Failed create() destroyed an earlier object!");
+
+    threw = false;
+    try {
+        allocator.create_array<ThrowingCounter>(3, -1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    TEST_MESSAGE(threw && allocator.remaining_memory() == remaining, "Failed create_array() kept its space!");
+    allocator.dealloc();
+    TEST_MESSAGE(DestructionCounter::destroyed == 1 && allocator.remaining_memory() == 1024, "Failed create() changed the allocation count!");
+}
+
+// Test: Statistics track padding, high-water mark, failures and resets
+DEFINE_TEST_G(StatsRecordUsage, AllocationStatsTests) {
+    BasicBumpAllocatorUpwards<AllocationStats> allocator(64);
+
+    allocator.alloc<char>(1);
+    allocator.alloc<double>(2, "doubles"); // 7 bytes of padding after the char
+    allocator.alloc<int>(100);             // Does not fit
+
+    const AllocationStats& stats = allocator.stats();
+    TEST_MESSAGE(stats.allocations == 2, "Successful allocation count not recorded.");
+    TEST_MESSAGE(stats.padding_bytes == 7, "Alignment padding not recorded.");
+    TEST_MESSAGE(stats.high_water_mark == 24, "High-water mark not as expected.");
+    TEST_MESSAGE(stats.failed_allocations == 1, "Failed allocation not recorded.");
+    TEST_MESSAGE(stats.size_histogram[1] == 1 && stats.size_histogram[5] == 1, "Size histogram not as expected.");
+
+    allocator.dealloc();
+    allocator.dealloc();
+    TEST_MESSAGE(stats.resets == 1, "Reset not recorded.");
+    TEST_MESSAGE(stats.high_water_mark == 24, "High-water mark should survive a reset.");
+
+    std::ostringstream json;
+    stats.to_json(json);
+    TEST_MESSAGE(json.str().find("\"doubles\": {\"allocations\": 1, \"bytes\": 16") != std::string::npos, "Tagged call site missing from JSON output.");
+}
+
+// Test: The default policy adds no state to the allocator
+DEFINE_TEST_G(NoStatsHasZeroCost, AllocationStatsTests) {
+    //The allocator's data members without any StatsPolicy
+    struct LayoutWithoutStats {
+        HeapStore store;
+        char* heap;
+        char* heap_end;
+        char* next;
+        std::size_t allocation_count;
+        std::size_t total_allocations;
+        MutexLock alloc_lock;
+        DestructorRegistry destructors;
+    };
+    TEST_MESSAGE(sizeof(NoStats) == 1, "NoStats should be an empty policy.");
+    TEST_MESSAGE(sizeof(BumpAllocatorUpwards) == sizeof(LayoutWithoutStats), "NoStats should take no space in the allocator.");
+    TEST_MESSAGE(sizeof(BumpAllocatorUpwards) < sizeof(BasicBumpAllocatorUpwards<AllocationStats>), "Stats should only cost space when enabled.");
+}
+
+// Test: Any policy combination behaves like the original allocators
+DEFINE_TEST_G(PolicyCombinations, BasicBumpAllocatorTests) {
+    BasicBumpAllocator<Upwards, NoLock, NoStats, NewHeap> up(40);
+    BasicBumpAllocator<Downwards, NoLock, AllocationStats, NewHeap> down(40);
+
+    TEST_MESSAGE(up.alloc<int>(10) != nullptr && up.remaining_memory() == 0, "Single-threaded upward allocator failed exact fit!");
+    TEST_MESSAGE(down.alloc<int>(10) != nullptr && down.remaining_memory() == 0, "Single-threaded downward allocator failed exact fit!");
+    TEST_MESSAGE(up.alloc<char>(1) == nullptr && down.alloc<char>(1) == nullptr, "Allocation succeeded on a full heap!");
+    TEST_MESSAGE(down.stats().failed_allocations == 1, "Stats policy not wired into the downward allocator.");
+
+    up.dealloc();
+    down.dealloc();
+    TEST_MESSAGE(up.remaining_memory() == 40 && down.remaining_memory() == 40, "Policy allocators did not reset!");
+}
+
+// Test: The mmap backing store plugs in as a policy
+DEFINE_TEST_G(MmapBackingStorePolicy, BasicBumpAllocatorTests) {
+    BasicBumpAllocator<Upwards, MutexLock, NoStats, MmapHeap> allocator(1000);
+    TEST_MESSAGE(allocator.remaining_memory() >= 1000, "mmap backing store smaller than requested!");
+    TEST_MESSAGE(allocator.alloc<double>(100) != nullptr, "Allocation from the mmap backing store failed!");
+}
+
+// Test: Typed batch returns aligned, non-overlapping arrays
+DEFINE_TEST_G(TypedBatchAllocation, AllocBatchTests) {
+    BumpAllocator allocator(200, false);
+
+    auto batch = allocator.alloc_batch<char, double, int>(3, 4, 5);
+    char* chars = std::get<0>(batch);
+    double* doubles = std::get<1>(batch);
+    int* ints = std::get<2>(batch);
+    TEST_MESSAGE(chars != nullptr && doubles != nullptr && ints != nullptr, "Batch allocation failed!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(doubles) % alignof(double) == 0, "Batched doubles are misaligned!");
+    TEST_MESSAGE(reinterpret_cast<char*>(doubles) >= chars + 3 && reinterpret_cast<char*>(ints) >= reinterpret_cast<char*>(doubles + 4), "Batched arrays overlap!");
+
+    // Each array counts as one allocation for dealloc()
+    allocator.dealloc();
+    allocator.dealloc();
+    TEST_MESSAGE(allocator.remaining_memory() < 200, "Allocator reset before every batched allocation was freed!");
+    allocator.dealloc();
+    TEST_MESSAGE(allocator.remaining_memory() == 200, "Allocator did not reset after the batch was freed!");
+}
+
+// Test: A batch that does not fit allocates nothing
+DEFINE_TEST_G(BatchFailsAtomically, AllocBatchTests) {
+    BumpAllocatorDownwards allocator(64);
+
+    BumpAllocatorDownwards::BatchRequest requests[] = {{16, 8}, {16, 16}, {64, 4}};
+    void* results[3];
+    bool ok = allocator.alloc_batch(requests, 3, results);
+    TEST_MESSAGE(!ok, "Oversized batch succeeded unexpectedly!");
+    TEST_MESSAGE(results[0] == nullptr && results[1] == nullptr && results[2] == nullptr, "Failed batch returned pointers!");
+    TEST_MESSAGE(allocator.remaining_memory() == 64, "Failed batch consumed memory!");
+
+    requests[2].size = 32;
+    TEST_MESSAGE(allocator.alloc_batch(requests, 3, results), "Exact-fit batch failed!");
+    TEST_MESSAGE(allocator.remaining_memory() == 0, "Exact-fit batch left memory behind.");
+}
+
+// Test: Compile-time and runtime over-alignment, and rejection of invalid alignments
+DEFINE_TEST_G(OverAlignedAllocation, OverAlignmentTests) {
+    BumpAllocatorUpwards allocator(1024);
+
+    allocator.alloc<char>(1); // Knock the bump pointer off alignment
+    float* simd = allocator.alloc<float, 64>(16);
+    TEST_MESSAGE(simd != nullptr && reinterpret_cast<std::uintptr_t>(simd) % 64 == 0, "alloc<float, 64> is not 64-byte aligned!");
+
+    allocator.alloc<char>(1);
+    double* page = allocator.alloc_aligned<double>(2, 256);
+    TEST_MESSAGE(page != nullptr && reinterpret_cast<std::uintptr_t>(page) % 256 == 0, "alloc_aligned did not honour 256-byte alignment!");
+
+    std::size_t before = allocator.remaining_memory();
+    TEST_MESSAGE(allocator.alloc_aligned<char>(1, 48) == nullptr, "Non-power-of-two alignment was accepted!");
+    TEST_MESSAGE(allocator.alloc_bytes(8, 0) == nullptr, "Zero alignment was accepted!");
+    TEST_MESSAGE(allocator.remaining_memory() == before, "Invalid alignment consumed memory!");
+}
+
+// Test: Isolated allocations never share a cache line with their neighbours
+DEFINE_TEST_G(IsolatedAllocationsOwnTheirCacheLines, OverAlignmentTests) {
+    BumpAllocatorDownwards allocator(1024);
+    const std::uintptr_t line = BumpAllocatorDownwards::cache_line_size;
+
+    long* first = allocator.alloc_aligned<long>(1, alignof(long), true);
+    long* second = allocator.alloc_aligned<long>(1, alignof(long), true);
+    char* neighbour = allocator.alloc<char>(1);
+    TEST_MESSAGE(first != nullptr && second != nullptr && neighbour != nullptr, "Isolated allocation failed!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(first) % line == 0 && reinterpret_cast<std::uintptr_t>(second) % line == 0, "Isolated allocations are not cache-line aligned!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(first) / line != reinterpret_cast<std::uintptr_t>(second) / line, "Isolated allocations share a cache line!");
+    TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(neighbour) / line != reinterpret_cast<std::uintptr_t>(second) / line, "Plain allocation landed on an isolated cache line!");
+}
+
+// Test: The tail allocation resizes in place; other blocks are copied
+DEFINE_TEST_G(ResizeTailInPlace, ResizeLastTests) {
+    BumpAllocatorUpwards up(256);
+    int* values = up.alloc<int>(4);
+    values[3] = 42;
+    int* grown = up.resize_last(values, 4, 16);
+    TEST_MESSAGE(grown == values && grown[3] == 42, "Upwards tail did not grow in place!");
+    TEST_MESSAGE(up.remaining_memory() == 256 - 16 * sizeof(int), "Upwards grow did not move the bump pointer!");
+    TEST_MESSAGE(up.try_extend(grown, 16 * sizeof(int), 8 * sizeof(int)), "Upwards tail did not shrink in place!");
+    TEST_MESSAGE(up.remaining_memory() == 256 - 8 * sizeof(int), "Upwards shrink did not return memory!");
+
+    BumpAllocatorDownwards down(256);
+    int* low = down.alloc<int>(4);
+    low[0] = 7;
+    low[3] = 42;
+    TEST_MESSAGE(!down.try_extend(low, 4 * sizeof(int), 8 * sizeof(int)), "Downwards block claimed to grow without moving!");
+    int* moved = down.resize_last(low, 4, 8);
+    TEST_MESSAGE(moved == low - 4 && moved[0] == 7 && moved[3] == 42, "Downwards tail did not grow at its start!");
+    TEST_MESSAGE(down.remaining_memory() == 256 - 8 * sizeof(int), "Downwards grow used extra space!");
+
+    // Not the tail any more: copy, and the move still counts as one allocation
+    int* first = up.alloc<int>(2);
+    first[1] = 5;
+    up.alloc<int>(1);
+    int* copied = up.resize_last(first, 2, 4);
+    TEST_MESSAGE(copied != nullptr && copied != first && copied[1] == 5, "Non-tail resize did not copy!");
+    up.dealloc();
+    up.dealloc();
+    up.dealloc();
+    TEST_MESSAGE(up.remaining_memory() == 256, "Resize changed the allocation count!");
+
+    // Shrinking a block that is not the tail needs no memory, even in a full arena
+    BumpAllocatorUpwards full(64);
+    char* x = full.alloc<char>(32);
+    full.alloc<char>(32);
+    TEST_MESSAGE(full.resize_last(x, 32, 8) == x, "Non-tail shrink did not keep its block!");
+    TEST_MESSAGE(full.remaining_memory() == 0, "Non-tail shrink used arena space!");
+}
+
+// Test: Growing the tail in place moves the high-water mark without counting an allocation
+DEFINE_TEST_G(ResizeIsNotAnAllocation, ResizeLastTests) {
+    BasicBumpAllocatorUpwards<AllocationStats> allocator(256);
+    char* block = allocator.alloc<char>(8);
+    char* grown = allocator.resize_last(block, 8, 64);
+    TEST_MESSAGE(grown == block && allocator.try_extend(grown, 64, 128), "Tail did not grow in place!");
+    allocator.alloc<char>(1);
+    TEST_MESSAGE(allocator.resize_last(grown, 128, 120) == grown, "Non-tail shrink moved the block!");
+
+    const AllocationStats& stats = allocator.stats();
+    TEST_MESSAGE(stats.allocations == 2 && stats.bytes_allocated == 9, "Resizes were counted as allocations!");
+    TEST_MESSAGE(stats.high_water_mark == 129, "Growth did not raise the high-water mark!");
+}
+
+// Test: ArenaBuffer grows without copying while it is the tail
+DEFINE_TEST_G(ArenaBufferGrowth, ResizeLastTests) {
+    BumpAllocatorUpwards allocator(4096);
+    ArenaBuffer<int, BumpAllocatorUpwards> buffer(allocator);
+
+    TEST_MESSAGE(buffer.push_back(0), "First push_back failed!");
+    int* start = buffer.data();
+    for (int i = 1; i < 100; ++i) {
+        buffer.push_back(i);
+    }
+    TEST_MESSAGE(buffer.size() == 100 && buffer.data() == start, "Tail buffer was copied while growing!");
+    TEST_MESSAGE(buffer[0] == 0 && buffer[99] == 99, "Buffer contents are wrong after growing!");
+    TEST_MESSAGE(buffer.shrink_to_fit() && allocator.remaining_memory() == 4096 - 100 * sizeof(int), "shrink_to_fit did not return the slack!");
+
+    TEST_MESSAGE(!buffer.reserve(10000), "Oversized reserve succeeded unexpectedly!");
+    TEST_MESSAGE(buffer.size() == 100 && buffer[99] == 99, "Failed reserve changed the buffer!");
+
+    allocator.dealloc();
+    TEST_MESSAGE(allocator.remaining_memory() == 4096, "Buffer counted as more than one allocation!");
+
+    // Once another block follows the buffer, shrinking cannot give memory back and must not copy
+    ArenaBuffer<int, BumpAllocatorUpwards> covered(allocator);
+    for (int i = 0; i < 100; ++i) {
+        covered.push_back(i);
+    }
+    allocator.alloc<int>(1);
+    std::size_t remaining = allocator.remaining_memory();
+    int* data = covered.data();
+    TEST_MESSAGE(covered.shrink_to_fit() && allocator.remaining_memory() == remaining, "Non-tail shrink_to_fit used arena space!");
+    TEST_MESSAGE(covered.data() == data && covered.capacity() == 128, "Non-tail shrink_to_fit moved the buffer!");
+}
+
+// Node of an arena-resident linked list, linked with offset pointers
+struct SnapshotNode {
+    int value;
+    offset_ptr<SnapshotNode> next;
+};
+
+// Function to build a list of count nodes in allocator, returning the head
+template <typename Allocator>
+SnapshotNode* build_snapshot_list(Allocator& allocator, int count) {
+    SnapshotNode* head = nullptr;
+    for (int i = count; i > 0; --i) {
+        head = allocator.template create<SnapshotNode>(SnapshotNode{i, head});
+    }
+    return head;
+}
+
+// Test: A snapshot maps back at a new address with its offset pointers intact
+DEFINE_TEST_G(SnapshotRoundTrip, ArenaSnapshotTests) {
+    const char* path = "/tmp/bumpallocator_snapshot_test.bin";
+    {
+        BumpAllocatorDownwards allocator(4096);
+        allocator.alloc<char>(3); // Leave the payload at an odd offset
+        TEST_MESSAGE(save_snapshot(allocator, build_snapshot_list(allocator, 10), path), "save_snapshot failed!");
+    }
+
+    MappedSnapshot snapshot(path);
+    TEST_MESSAGE(snapshot.valid(), snapshot.error() ? snapshot.error() : "Snapshot is invalid!");
+    int sum = 0;
+    int count = 0;
+    for (const SnapshotNode* node = snapshot.root<SnapshotNode>(); node != nullptr; node = node->next.get()) {
+        TEST_MESSAGE(reinterpret_cast<std::uintptr_t>(node) % alignof(SnapshotNode) == 0, "Mapped node is misaligned!");
+        sum += node->value;
+        count++;
+    }
+    TEST_MESSAGE(count == 10 && sum == 55, "Mapped list does not match the saved one!");
+    std::remove(path);
+}
+
+// Test: Corrupt and foreign files are rejected instead of mapped
+DEFINE_TEST_G(SnapshotRejectsBadFiles, ArenaSnapshotTests) {
+    const char* path = "/tmp/bumpallocator_snapshot_corrupt.bin";
+    BumpAllocatorUpwards allocator(1024);
+    SnapshotNode* head = build_snapshot_list(allocator, 4);
+    TEST_MESSAGE(!save_snapshot(allocator, reinterpret_cast<SnapshotNode*>(&allocator), path), "Root outside the arena was accepted!");
+    TEST_MESSAGE(save_snapshot(allocator, head, path), "save_snapshot failed!");
+
+    // Flip one payload byte
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('\x5a');
+    }
+    MappedSnapshot corrupt(path);
+    TEST_MESSAGE(!corrupt.valid() && corrupt.root<SnapshotNode>() == nullptr, "Corrupt snapshot was accepted!");
+    MappedSnapshot unchecked(path, false);
+    TEST_MESSAGE(unchecked.valid(), "Unverified load rejected a well-formed header!");
+
+    MappedSnapshot missing("/tmp/bumpallocator_snapshot_missing.bin");
+    TEST_MESSAGE(!missing.valid() && missing.error() != nullptr, "Missing file did not report an error!");
+    std::remove(path);
+}
+
+// Test: A child process allocates from and reads the parent's shared arena
+DEFINE_TEST_G(SharedAcrossProcesses, SharedBumpAllocatorTests) {
+    std::string name = "/bumpallocator_test_" + std::to_string(getpid());
+    SharedBumpAllocator::remove(name.c_str());
+    SharedBumpAllocator parent(name.c_str(), 4096);
+
+    int* shared = parent.alloc<int>(4);
+    shared[0] = 1234;
+    parent.publish_root(shared);
+
+    pid_t child = fork();
+    if (child == 0) {
+        // Child: attach, check the parent's data and add to the shared count
+        SharedBumpAllocator attached(name.c_str());
+        int* root = attached.root<int>();
+        int* extra = attached.alloc<int>(1);
+        bool ok = root != nullptr && root[0] == 1234 && extra != nullptr && attached.allocation_count() == 2;
+        if (extra != nullptr) {
+            *extra = 5678;
+        }
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    TEST_MESSAGE(WIFEXITED(status) && WEXITSTATUS(status) == 0, "Child could not use the shared arena!");
+    TEST_MESSAGE(parent.allocation_count() == 2, "Child allocation is not visible to the parent!");
+    TEST_MESSAGE(parent.at<int>(parent.offset_of(shared + 4))[0] == 5678, "Child's data is not visible to the parent!");
+
+    // The shared count resets the heap only once both allocations are freed
+    parent.dealloc();
+    TEST_MESSAGE(parent.remaining_memory() < 4096, "Shared arena reset while the child's allocation was live!");
+    parent.dealloc();
+    TEST_MESSAGE(parent.remaining_memory() == 4096, "Shared arena did not reset!");
+    TEST_MESSAGE(SharedBumpAllocator::remove(name.c_str()), "Shared segment could not be removed!");
+}
+
+// Test: rollback only succeeds while this handle's allocations are on top
+DEFINE_TEST_G(SharedRollbackNeedsOwnTop, SharedBumpAllocatorTests) {
+    std::string name = "/bumpallocator_rollback_" + std::to_string(getpid());
+    SharedBumpAllocator::remove(name.c_str());
+    SharedBumpAllocator first(name.c_str(), 1024);
+    SharedBumpAllocator second(name.c_str(), 1024); // Attaches to the same segment
+
+    SharedBumpAllocator::Marker marker = first.mark();
+    first.alloc<double>(4);
+    TEST_MESSAGE(first.rollback(marker) && first.remaining_memory() == 1024, "Uncontended rollback failed!");
+
+    marker = first.mark();
+    first.alloc<double>(4);
+    second.alloc<double>(4);
+    TEST_MESSAGE(!first.rollback(marker), "Rollback discarded another handle's allocation!");
+    TEST_MESSAGE(second.allocation_count() == 2, "Failed rollback changed the shared state!");
+    SharedBumpAllocator::remove(name.c_str());
+}
+
+// Versioned table rebuilt in an EpochArenaRing; every entry holds the version
+struct EpochTable {
+    int version;
+    int entries[64];
+};
+
+// Test: An arena is not reset while a reader is pinned to its epoch
+DEFINE_TEST_G(PinnedEpochBlocksReset, EpochArenaRingTests) {
+    EpochArenaRing<BumpAllocatorUpwards> ring(4096);
+    TEST_MESSAGE(ring.pin().root<EpochTable>() == nullptr, "Epoch 0 has a root before anything was published!");
+
+    EpochTable* table = ring.begin_update().create<EpochTable>();
+    table->version = 1;
+    ring.publish(table);
+    {
+        // Keep reading version 1 while version 2 is published
+        auto reader = ring.pin();
+        TEST_MESSAGE(reader.epoch() == 1 && reader.root<EpochTable>()->version == 1, "Reader did not pin the current epoch!");
+        table = ring.begin_update().create<EpochTable>();
+        table->version = 2;
+        ring.publish(table);
+        TEST_MESSAGE(ring.try_begin_update() == nullptr, "Arena was handed out while a reader was pinned to it!");
+        TEST_MESSAGE(reader.root<EpochTable>()->version == 1, "Pinned data changed under the reader!");
+    }
+    TEST_MESSAGE(ring.readers(1) == 0, "Reader pin was not released!");
+    TEST_MESSAGE(ring.try_begin_update() != nullptr, "Arena was not reusable after its reader left!");
+    TEST_MESSAGE(ring.pin().root<EpochTable>()->version == 2, "Readers do not see the latest epoch!");
+}
+
+// Test: Readers always see a complete table while a writer keeps rebuilding it
+DEFINE_TEST_G(ConcurrentReadersSeeConsistentEpochs, EpochArenaRingTests) {
+    EpochArenaRing<BumpAllocatorUpwards, 3> ring(4096);
+    std::atomic<bool> done(false);
+    std::atomic<int> torn_reads(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto guard = ring.pin();
+                const EpochTable* table = guard.root<EpochTable>();
+                if (table == nullptr) {
+                    continue;
+                }
+                for (int value : table->entries) {
+                    if (value != table->version) {
+                        torn_reads++;
+                    }
+                }
+            }
+        });
+    }
+    for (int version = 1; version <= 2000; ++version) {
+        EpochTable* table = ring.begin_update().create<EpochTable>();
+        table->version = version;
+        for (int& value : table->entries) {
+            value = version;
+        }
+        ring.publish(table);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    TEST_MESSAGE(torn_reads == 0, "A reader saw a table that was being rebuilt!");
+    TEST_MESSAGE(ring.epoch() == 2000, "Not every epoch was published!");
+}
+
+// Test: Benchmark::run orders its statistics and counts calls correctly
+DEFINE_TEST_G(BenchmarkRunStatistics, BenchmarkHarnessTests) {
+    BumpAllocatorUpwards allocator(1024);
+    std::size_t calls = 0;
+    Benchmark::Options options;
+    options.warmup = 2;
+    options.samples = 5;
+    options.min_sample_ns = 1000;
+
+    Benchmark::Stats stats = Benchmark::run(options, [&] {
+        ScopedRollback<BumpAllocatorUpwards> scope(allocator);
+        Benchmark::do_not_optimize(allocator.alloc<int>(16));
+        calls++;
+    });
+    TEST_MESSAGE(stats.samples == 5 && stats.iterations >= 1, "Wrong number of samples!");
+    TEST_MESSAGE(stats.min <= stats.median && stats.median <= stats.p99 && stats.min <= stats.mean, "Statistics are out of order!");
+    TEST_MESSAGE(calls >= 2 + 5 * stats.iterations, "Warmup or samples were skipped!");
+    TEST_MESSAGE(allocator.remaining_memory() == 1024, "Rolled-back workload leaked memory between calls!");
+
+    options.use_tsc = true;
+    stats = Benchmark::run(options, [] {});
+    TEST_MESSAGE(std::string(stats.unit) == (Benchmark::has_tsc ? "cycles" : "ns"), "TSC results report the wrong unit!");
+}
+
+// Test: Counters either count or report why not, without failing the benchmark
+DEFINE_TEST_G(PerfCountersDegradeGracefully, BenchmarkHarnessTests) {
+    PerfCounters counters;
+    counters.start();
+    volatile unsigned sink = 0; // Unsigned, so the sum may wrap
+    for (int i = 0; i < 100000; ++i) {
+        sink = sink + i;
+    }
+    counters.stop();
+    PerfCounters::Reading reading = counters.read();
+
+    if (!counters.available()) {
+        TEST_MESSAGE(counters.error() != nullptr, "Unavailable counters gave no reason!");
+        for (bool valid : reading.valid) {
+            TEST_MESSAGE(!valid, "Unavailable counter reported a value!");
+        }
+    } else if (reading.valid[PerfCounters::instructions]) {
+        TEST_MESSAGE(reading.values[PerfCounters::instructions] > 100000, "Instruction counter missed the loop!");
+    }
+}
+
+// Test: A recorded trace is written on destruction and reads back with sizes, alignments, tags and resets
+DEFINE_TEST_G(TraceRoundTrip, AllocationTraceTests) {
+    const char* path = "/tmp/bumpallocator_trace_test.bin";
+    {
+        BasicBumpAllocatorUpwards<TraceRecorder> allocator(256, TraceRecorder(path));
+        allocator.alloc<int>(4, "ints");
+        allocator.alloc_bytes(32, 64, "block");
+        allocator.alloc_bytes(1024, 8, "ints"); // Does not fit
+        allocator.dealloc();
+        allocator.dealloc(); // Returns to empty
+    }
+
+    Trace trace;
+    TEST_MESSAGE(read_trace(path, trace), "Trace file could not be read!");
+    TEST_MESSAGE(trace.heap_size == 256, "Trace lost the heap size!");
+    TEST_MESSAGE(trace.tags.size() == 3 && trace.tags[1] == "ints" && trace.tags[2] == "block", "Tag table is wrong!");
+    TEST_MESSAGE(trace.records.size() == 6, "Wrong number of events recorded!");
+    if (trace.records.size() == 6) {
+        TEST_MESSAGE(trace.records[0].kind == TraceRecord::alloc && trace.records[0].value == 16 &&
+                     trace.records[0].alignment_log2 == 2 && trace.records[0].tag == 1, "First request recorded wrongly!");
+        TEST_MESSAGE(trace.records[1].alignment_log2 == 6 && trace.records[1].tag == 2, "Alignment or tag recorded wrongly!");
+        TEST_MESSAGE(trace.records[2].kind == TraceRecord::failed_alloc && trace.records[2].tag == 1, "Failed request not marked!");
+        TEST_MESSAGE(trace.records[3].kind == TraceRecord::dealloc && trace.records[4].kind == TraceRecord::dealloc &&
+                     trace.records[5].kind == TraceRecord::reset, "Dealloc and reset events recorded wrongly!");
+    }
+
+    // A header that claims more records than the file holds is rejected before anything is allocated
+    for (std::uint64_t record_count : {std::uint64_t(7), std::uint64_t(1) << 40}) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offsetof(TraceHeader, record_count));
+        file.write(reinterpret_cast<const char*>(&record_count), sizeof(record_count));
+        file.close();
+        TEST_MESSAGE(!read_trace(path, trace), "Trace with too few records was accepted!");
+    }
+    std::remove(path);
+    TEST_MESSAGE(!read_trace("/tmp/bumpallocator_trace_missing.bin", trace), "Missing trace file was accepted!");
+}
+
+// Test: Replaying a trace rebuilds the recorded rollbacks and leaves the allocator as it found it
+DEFINE_TEST_G(TraceReplayRollbacks, AllocationTraceTests) {
+    BasicBumpAllocatorUpwards<TraceRecorder> recorded(1024);
+    auto outer = recorded.mark();
+    recorded.alloc<double>(4);
+    auto inner = recorded.mark();
+    recorded.alloc<char>(100);
+    recorded.alloc<char>(100);
+    recorded.rollback(inner);   // Back to one allocation
+    recorded.alloc<char>(8);
+    recorded.rollback(outer);   // Back to empty
+
+    Trace trace;
+    trace.heap_size = 1024;
+    trace.records = recorded.stats().records();
+    TraceReplayer replayer(trace);
+    TEST_MESSAGE(replayer.allocations() == 4, "Replay lost allocations!");
+    TEST_MESSAGE(replayer.peak_bytes() == 232, "Peak live bytes are wrong!");
+
+    BumpAllocatorUpwards allocator(1024);
+    TEST_MESSAGE(replayer.run(allocator) == 4, "Replayed allocations failed!");
+    TEST_MESSAGE(allocator.remaining_memory() == 1024, "Replay did not roll the allocator back!");
+    TEST_MESSAGE(replayer.run(allocator) == 4 && allocator.remaining_memory() == 1024, "Replay is not repeatable!");
+
+    BumpAllocatorUpwards small(240); // Fits the peak only if the rollbacks are replayed
+    TEST_MESSAGE(replayer.run(small) == 4, "Rollbacks were not replayed!");
+}
+
+// Test: Failed batches and resizes are recorded so that a replay makes the same calls with the same outcomes
+DEFINE_TEST_G(TraceReplayBatchesAndResizes, AllocationTraceTests) {
+    using RecordingAllocator = BasicBumpAllocatorUpwards<TraceRecorder>;
+    using Request = RecordingAllocator::BatchRequest;
+    RecordingAllocator recorded(256);
+    void* block = recorded.alloc_bytes(16, 8);
+    block = recorded.resize_last(block, 16, 48, 8);   // The tail grows where it lies
+    recorded.alloc_bytes(8, 8);
+    recorded.resize_last(block, 48, 64, 8);           // No longer the tail: moved
+    void* results[3];
+    const Request too_big[] = {{32, 8}, {32, 8}, {1000, 8}};
+    recorded.alloc_batch(too_big, 3, results);        // Fails as a whole
+    const Request fits[] = {{8, 8}, {8, 8}};
+    recorded.alloc_batch(fits, 2, results);
+
+    const TraceRecord::Kind expected[] = {TraceRecord::alloc, TraceRecord::resize, TraceRecord::alloc, TraceRecord::move,
+                                          TraceRecord::failed_alloc, TraceRecord::failed_alloc, TraceRecord::failed_alloc,
+                                          TraceRecord::alloc, TraceRecord::alloc};
+    const std::vector<TraceRecord>& records = recorded.stats().records();
+    bool kinds = records.size() == 9;
+    for (std::size_t i = 0; kinds && i < records.size(); ++i) {
+        kinds = records[i].kind == expected[i];
+    }
+    TEST_MESSAGE(kinds, "Batch failures or resizes recorded wrongly!");
+
+    Trace trace;
+    trace.records = records;
+    TraceReplayer replayer(trace);
+    TEST_MESSAGE(replayer.allocations() == 4, "Failed batch requests were replayed!");
+
+    //Record the replay: it must repeat every successful event, then roll back to the start
+    RecordingAllocator replayed(256);
+    TEST_MESSAGE(replayer.run(replayed) == 4, "Replayed allocations failed!");
+    const std::vector<TraceRecord>& again = replayed.stats().records();
+    bool same = again.size() == 7 && again.back().kind == TraceRecord::rollback && again.back().value == 0;
+    for (std::size_t i = 0, j = 0; same && i < records.size(); ++i) {
+        if (records[i].kind != TraceRecord::failed_alloc) {
+            same = again[j].kind == records[i].kind && again[j].value == records[i].value;
+            j++;
+        }
+    }
+    TEST_MESSAGE(same, "Replay diverged from the recorded resizes!");
+    TEST_MESSAGE(replayed.remaining_memory() == 256, "Replay did not roll the allocator back!");
+}
+
+// Test: The same seed gives the same stream, and every request respects the size bounds and its alignment
+DEFINE_TEST_G(GeneratorIsSeededAndBounded, WorkloadGeneratorTests) {
+    const SizeDistribution distributions[] = {SizeDistribution::uniform, SizeDistribution::log_normal,
+                                              SizeDistribution::zipf, SizeDistribution::bimodal};
+    for (SizeDistribution distribution : distributions) {
+        WorkloadParams params;
+        params.distribution = distribution;
+        params.min_size = 8;
+        params.max_size = 8192;
+        params.alignments = {1, 16, 64};
+        params.seed = 42;
+        WorkloadGenerator first(params), second(params);
+        bool same = true, bounded = true;
+        for (int i = 0; i < 10000; ++i) {
+            AllocationRequest a = first.next(), b = second.next();
+            same &= a.size == b.size && a.alignment == b.alignment;
+            bounded &= a.size >= 8 && a.size <= 8192 && a.size % a.alignment == 0;
+        }
+        TEST_MESSAGE(same, "Equal seeds gave different streams!");
+        TEST_MESSAGE(bounded, "A request is out of bounds or misaligned!");
+
+        params.seed = 43;
+        WorkloadGenerator other(params);
+        bool differs = false;
+        for (int i = 0; i < 100; ++i) {
+            differs |= other.next().size != first.next().size;
+        }
+        TEST_MESSAGE(differs, "Different seeds gave the same stream!");
+    }
+}
+
+// Test: The default bimodal stream has both modes, and inconsistent parameters are rejected
+DEFINE_TEST_G(GeneratorValidatesParams, WorkloadGeneratorTests) {
+    WorkloadParams params;
+    params.distribution = SizeDistribution::bimodal;
+    WorkloadGenerator generator(params);
+    std::set<std::size_t> large_sizes;
+    for (int i = 0; i < 10000; ++i) {
+        std::size_t size = generator.next().size;
+        if (size > params.small_max) {
+            large_sizes.insert(size);
+        }
+        TEST_MESSAGE(size <= params.max_size && (size <= params.small_max || size >= params.large_min), "Bimodal size between the modes!");
+    }
+    TEST_MESSAGE(large_sizes.size() > 10, "Default bimodal large requests all have one size!");
+
+    auto rejected = [](const WorkloadParams& bad) {
+        try {
+            WorkloadGenerator unused(bad);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    WorkloadParams bad = params;
+    bad.large_min = 4096; // Above max_size
+    TEST_MESSAGE(rejected(bad), "large_min above max_size was accepted!");
+    bad = WorkloadParams();
+    bad.min_size = 2048;
+    TEST_MESSAGE(rejected(bad), "min_size above max_size was accepted!");
+    bad = WorkloadParams();
+    bad.alignments = {8, 12};
+    TEST_MESSAGE(rejected(bad), "Alignment that is not a power of two was accepted!");
+}
+
+// Test: The distributions have their intended shape, and the trace resets as often as asked
+DEFINE_TEST_G(GeneratorDistributionShapes, WorkloadGeneratorTests) {
+    WorkloadParams zipf;
+    zipf.distribution = SizeDistribution::zipf;
+    zipf.min_size = 8;
+    zipf.max_size = 4096;
+    zipf.zipf_exponent = 1.5;
+    WorkloadGenerator zipf_generator(zipf);
+    int smallest = 0;
+    for (int i = 0; i < 10000; ++i) {
+        smallest += zipf_generator.next().size == 8;
+    }
+    TEST_MESSAGE(smallest > 3000, "Zipf does not favor the smallest size!");
+
+    WorkloadParams bimodal;
+    bimodal.distribution = SizeDistribution::bimodal;
+    bimodal.small_fraction = 0.75;
+    bimodal.max_size = 8192;
+    WorkloadGenerator bimodal_generator(bimodal);
+    int small = 0, middle = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::size_t size = bimodal_generator.next().size;
+        small += size <= 64;
+        middle += size > 64 && size < bimodal.large_min;
+    }
+    TEST_MESSAGE(small > 7000 && small < 8000 && middle == 0, "Bimodal sizes are not split as configured!");
+
+    WorkloadParams log_normal;
+    log_normal.distribution = SizeDistribution::log_normal;
+    log_normal.median_size = 256;
+    log_normal.max_size = 1 << 20;
+    WorkloadGenerator log_normal_generator(log_normal);
+    int below = 0;
+    for (int i = 0; i < 10000; ++i) {
+        below += log_normal_generator.next().size < 256;
+    }
+    TEST_MESSAGE(below > 4500 && below < 5500, "Log-normal median is off!");
+
+    WorkloadParams resets;
+    resets.reset_every = 100;
+    Trace trace = WorkloadGenerator(resets).trace(1000);
+    std::size_t rollbacks = 0;
+    for (const TraceRecord& record : trace.records) {
+        rollbacks += record.kind == TraceRecord::rollback;
+    }
+    TEST_MESSAGE(rollbacks == 10, "Generated trace does not reset every 100 requests!");
+    TraceReplayer replayer(trace);
+    BumpAllocatorUpwards allocator(static_cast<std::size_t>(replayer.peak_bytes()) + 100 * 8);
+    TEST_MESSAGE(replayer.run(allocator) == 1000, "Generated trace does not replay!");
+}
+
+// Test: Percentiles are exact for small values and within the bucket precision above, and merging adds up
+DEFINE_TEST_G(HistogramPercentilesAndMerge, LatencyHistogramTests) {
+    LatencyHistogram low, high;
+    for (std::uint64_t v = 1; v <= 30; ++v) {
+        low.record(v);
+    }
+    TEST_MESSAGE(low.percentile(50) == 15 && low.percentile(100) == 30 && low.min() == 1, "Small values are not exact!");
+
+    for (std::uint64_t v = 1000; v <= 100000; v += 1000) {
+        high.record(v);
+    }
+    for (double percent : {50.0, 90.0, 99.0}) {
+        double exact = 1000.0 * std::ceil(percent);
+        double reported = static_cast<double>(high.percentile(percent));
+        TEST_MESSAGE(reported >= exact && reported <= exact * (1 + 1.0 / LatencyHistogram::sub_bucket_count), "Percentile outside bucket precision!");
+    }
+    TEST_MESSAGE(high.percentile(100) == 100000 && high.max() == 100000, "Maximum is not exact!");
+
+    low.merge(high);
+    TEST_MESSAGE(low.count() == 130 && low.min() == 1 && low.max() == 100000, "Merge lost values!");
+    TEST_MESSAGE(low.percentile(23.0) == 30, "Merged percentile is wrong!");
+    low.record(std::numeric_limits<std::uint64_t>::max());
+    TEST_MESSAGE(low.percentile(100) == std::numeric_limits<std::uint64_t>::max(), "Largest value not recorded!");
+}
+
+// Test: The calibrated timer reports an empty call as close to zero and keeps the call's result
+DEFINE_TEST_G(LatencyTimerSubtractsOverhead, LatencyHistogramTests) {
+    Benchmark::LatencyTimer timer;
+    LatencyHistogram empty, allocs;
+    for (int i = 0; i < 10000; ++i) {
+        timer.time(empty, [] {});
+    }
+    TEST_MESSAGE(empty.count() == 10000, "Timer lost calls!");
+    TEST_MESSAGE(empty.percentile(50) <= timer.overhead_per_call() / 2 + 5, "Timer overhead was not subtracted!");
+
+    BumpAllocatorUpwards allocator(1024);
+    int* value = timer.time(allocs, [&] { return allocator.alloc<int>(1); });
+    TEST_MESSAGE(value != nullptr && allocs.count() == 1, "Timed call lost its result!");
+}
+
+// Helper: Stats with the given median (and mean) and spread over 31 samples
+static Benchmark::Stats stats_with(double median, double stddev) {
+    Benchmark::Stats stats;
+    stats.samples = 31;
+    stats.iterations = 8;
+    stats.min = median - stddev;
+    stats.median = median;
+    stats.mean = median;
+    stats.p99 = median + 2 * stddev;
+    stats.stddev = stddev;
+    return stats;
+}
+
+// Test: Results and metadata survive a write and read, including names that need escaping
+DEFINE_TEST_G(ResultsRoundTrip, BenchmarkResultsTests) {
+    const char* path = "/tmp/bumpallocator_results_test.json";
+    ResultFile saved;
+    saved.metadata = collect_metadata();
+    saved.results.push_back(BenchmarkResult{"Small Allocations - Up", stats_with(1234.5, 10.25)});
+    saved.results.push_back(BenchmarkResult{"quoted \"name\"\tand\\slash", stats_with(0.125, 0)});
+    saved.results.back().stats.unit = "cycles";
+    TEST_MESSAGE(write_results(path, saved), "Results could not be written!");
+
+    ResultFile loaded;
+    TEST_MESSAGE(read_results(path, loaded), "Results could not be read back!");
+    TEST_MESSAGE(loaded.metadata == saved.metadata && loaded.metadata.count("compiler") == 1, "Metadata changed in the round trip!");
+    TEST_MESSAGE(loaded.results.size() == 2, "Wrong number of results read back!");
+    if (loaded.results.size() == 2) {
+        TEST_MESSAGE(loaded.results[0].name == saved.results[0].name && loaded.results[0].stats.median == 1234.5 &&
+                     loaded.results[0].stats.stddev == 10.25 && loaded.results[0].stats.samples == 31, "Statistics changed in the round trip!");
+        TEST_MESSAGE(loaded.results[1].name == saved.results[1].name && std::string(loaded.results[1].stats.unit) == "cycles",
+                     "Escaped name or unit changed in the round trip!");
+    }
+    std::remove(path);
+
+    std::ofstream(path) << "{\"results\": [";
+    TEST_MESSAGE(!read_results(path, loaded), "Truncated result file was accepted!");
+    std::remove(path);
+}
+
+// Helper: Append one result per run with the given medians to file
+static void add_runs(ResultFile& file, const char* name, std::initializer_list<double> medians) {
+    for (double median : medians) {
+        file.results.push_back(BenchmarkResult{name, stats_with(median, 1)});
+    }
+}
+
+// Test: Only changes beyond the threshold that are significant across runs count as regressions or improvements
+DEFINE_TEST_G(CompareFlagsSignificantChanges, BenchmarkResultsTests) {
+    ResultFile old_run, new_run;
+    add_runs(old_run, "slower", {100, 101, 99, 100, 102});
+    add_runs(old_run, "noisy", {100, 130, 80, 110, 90});
+    add_runs(old_run, "faster", {100, 101, 99, 100, 102});
+    add_runs(old_run, "small change", {100, 100.1, 99.9, 100, 100.2});
+    add_runs(old_run, "removed", {100, 100});
+    add_runs(new_run, "slower", {120, 121, 119, 122, 120});
+    add_runs(new_run, "noisy", {120, 95, 140, 105, 125});
+    add_runs(new_run, "faster", {80, 81, 79, 80, 82});
+    add_runs(new_run, "small change", {102, 102.1, 101.9, 102, 102.2});
+    add_runs(new_run, "added", {100, 100});
+
+    std::vector<Comparison> comparisons = compare_results(old_run, new_run, 5);
+    TEST_MESSAGE(comparisons.size() == 6, "Every benchmark of both runs should be listed once!");
+    if (comparisons.size() == 6) {
+        TEST_MESSAGE(comparisons[0].verdict == Comparison::regressed && std::fabs(comparisons[0].change_percent - 20) < 1e-9 &&
+                     comparisons[0].old_runs == 5 && comparisons[0].new_runs == 5, "Clear slowdown not flagged!");
+        TEST_MESSAGE(comparisons[1].verdict == Comparison::unchanged, "Slowdown within the run-to-run noise was flagged!");
+        TEST_MESSAGE(comparisons[2].verdict == Comparison::improved, "Clear speedup not reported!");
+        TEST_MESSAGE(comparisons[3].verdict == Comparison::unchanged, "Change below the threshold was flagged!");
+        TEST_MESSAGE(comparisons[4].verdict == Comparison::missing && comparisons[5].verdict == Comparison::missing, "Unmatched benchmarks not reported!");
+    }
+    TEST_MESSAGE(compare_results(old_run, new_run, 25)[0].verdict == Comparison::unchanged, "Threshold is not configurable!");
+
+    std::ostringstream report;
+    TEST_MESSAGE(print_comparison(report, old_run, new_run, 5) == 1, "Printed comparison miscounted regressions!");
+
+    //A single run per side has no run-to-run spread to test against
+    ResultFile one_old, one_new;
+    add_runs(one_old, "slower", {100});
+    add_runs(one_new, "slower", {120});
+    comparisons = compare_results(one_old, one_new, 5);
+    TEST_MESSAGE(comparisons.size() == 1 && comparisons[0].verdict == Comparison::unchanged &&
+                 std::fabs(comparisons[0].change_percent - 20) < 1e-9, "Single runs were judged!");
+
+    TEST_MESSAGE(t_critical_99(2) > 9.9 && t_critical_99(2.7) > 9.9 && t_critical_99(10) > 3.16 &&
+                 t_critical_99(1e6) > 2.57, "Critical values are below Student's t!");
+}
+
+// Test: Runs of the same code, drifting between runs far more than within them, report no regressions
+DEFINE_TEST_G(CompareRunAgainstItself, BenchmarkResultsTests) {
+    ResultFile old_run, new_run;
+    add_runs(old_run, "std::vector", {100, 112, 95, 118, 104});
+    add_runs(old_run, "ArenaBuffer - Down", {50, 61, 55, 47, 58});
+    add_runs(new_run, "std::vector", {108, 97, 121, 99, 103});
+    add_runs(new_run, "ArenaBuffer - Down", {57, 49, 63, 52, 54});
+
+    std::ostringstream report;
+    TEST_MESSAGE(print_comparison(report, old_run, old_run, 5) == 0, "A run compared with itself regressed!");
+    TEST_MESSAGE(print_comparison(report, old_run, new_run, 5) == 0, "Run-to-run drift was reported as a regression!");
+    for (const Comparison& comparison : compare_results(old_run, new_run, 5)) {
+        TEST_MESSAGE(comparison.verdict == Comparison::unchanged, "Run-to-run drift changed a verdict!");
+    }
+
+    //Files given to read_runs are merged into one run each
+    const char* paths[] = {"/tmp/bumpallocator_runs_1.json", "/tmp/bumpallocator_runs_2.json"};
+    for (const char* path : paths) {
+        write_results(path, old_run);
+    }
+    ResultFile merged;
+    TEST_MESSAGE(read_runs(std::string(paths[0]) + "," + paths[1], merged) && merged.results.size() == 20,
+                 "Result files were not merged!");
+    TEST_MESSAGE(!read_runs(std::string(paths[0]) + ",/tmp/bumpallocator_runs_missing.json", merged), "Missing run was accepted!");
+    for (const char* path : paths) {
+        std::remove(path);
+    }
+}
+
 int main() {
     bool pass = true;
     for (auto group : groups) {
@@ -0,0 +1,418 @@
+#ifndef ALLOCATIONTRACE_HPP
+#define ALLOCATIONTRACE_HPP
+
+#include <algorithm>  // For std::max
+#include <chrono>     // For record timestamps
+#include <cstddef>    // For size_t
+#include <cstdint>    // For fixed-width record fields
+#include <cstring>    // For std::memcmp
+#include <fstream>    // For reading and writing trace files
+#include <map>        // For the tag table
+#include <ostream>    // For to_json
+#include <string>     // For tag names and the output path
+#include <utility>    // For std::move
+#include <vector>     // For the record buffer
+
+// Allocation traces: record what a program asks an allocator for, then replay it.
+//
+// TraceRecorder is a StatsPolicy for BasicBumpAllocator. It logs every
+// allocation request (size, alignment, tag, time since the previous event),
+// every resize_last() and try_extend(), every dealloc(), rollback() and reset
+// into a memory buffer, and writes the
+// buffer to a binary trace file when the allocator is destroyed. Each event is
+// a 16-byte TraceRecord; tags are stored once in a table and referenced by id.
+//
+// read_trace loads a file back, and TraceReplayer turns it into a sequence of
+// alloc_bytes/resize_last/dealloc/mark/rollback calls that can be run against
+// any allocator with that interface (see TraceReplay.cpp, which also drives malloc).
+// Trace files use the byte order of the machine that wrote them.
+
+constexpr std::uint32_t trace_version = 2;   // Bumped when the file layout changes (2 added resize and move)
+constexpr char trace_magic[8] = {'B', 'U', 'M', 'P', 'T', 'R', 'C', 'E'};
+
+// One recorded event
+struct TraceRecord {
+    enum Kind : std::uint8_t {
+        alloc,          // value = requested bytes
+        failed_alloc,   // value = requested bytes; the request did not fit
+        dealloc,        // value unused
+        rollback,       // value = allocation count after the rollback
+        reset,          // value unused; the allocator returned to empty
+        resize,         // value = new size of the tail block, resized where it lies
+        move            // value = new size of a block copied to a new allocation (still one allocation)
+    };
+
+    std::uint64_t value;          // Size or allocation count, depending on kind
+    std::uint32_t delta_ns;       // Nanoseconds since the previous event (saturates at 2^32 - 1)
+    std::uint16_t tag;            // Index into the tag table, 0 for no tag
+    std::uint8_t alignment_log2;  // log2 of the requested alignment
+    std::uint8_t kind;            // Kind
+};
+
+static_assert(sizeof(TraceRecord) == 16, "Trace records must stay 16 bytes");
+
+// File header, followed by the tag table (u16 length + bytes per tag) and the records
+struct TraceHeader {
+    char magic[8];                // trace_magic
+    std::uint32_t version;        // trace_version of the writer
+    std::uint32_t tag_count;      // Entries in the tag table, including the empty tag 0
+    std::uint64_t record_count;   // Number of TraceRecords
+    std::uint64_t heap_size;      // Heap size of the recorded allocator
+};
+
+// A trace loaded by read_trace
+struct Trace {
+    std::size_t heap_size = 0;            // Heap size of the recorded allocator
+    std::vector<std::string> tags;        // Tag names by id; tags[0] is ""
+    std::vector<TraceRecord> records;     // Events in order
+};
+
+// Statistics policy that records an allocation trace
+class TraceRecorder {
+public:
+    // Constructor: Records into memory and writes to path when the allocator is destroyed (never if path is empty)
+    explicit TraceRecorder(std::string path = std::string()) : output_path(std::move(path)), heap_size(0) {
+        tag_names.push_back(std::string());
+        reserve_records(4096);
+    }
+
+    void on_create(std::size_t size) {
+        heap_size = size;
+        last_event = std::chrono::steady_clock::now();
+    }
+
+    void on_destroy(std::size_t) {
+        if (!output_path.empty()) {
+            save(output_path.c_str());
+        }
+    }
+
+    void on_request(std::size_t size, std::size_t alignment, const char* tag) {
+        if (pending == no_pending) {
+            pending = trace.size();
+        }
+        append(TraceRecord::alloc, size, log2(alignment), tag_id(tag));
+    }
+
+    void on_alloc(std::size_t, std::size_t, std::size_t, const char*) {
+        pending = no_pending;
+    }
+
+    // Hook: the pending requests did not fit (all of them for a failed alloc_batch), so replays should skip them
+    void on_failure(std::size_t, const char*) {
+        if (pending != no_pending) {
+            for (std::size_t i = pending; i < trace.size(); ++i) {
+                trace[i].kind = TraceRecord::failed_alloc;
+            }
+            pending = no_pending;
+        }
+    }
+
+    void on_resize(std::size_t, std::size_t new_size, std::size_t alignment, bool moved, std::size_t, const char* tag) {
+        append(moved ? TraceRecord::move : TraceRecord::resize, new_size, log2(alignment), tag_id(tag));
+    }
+
+    void on_dealloc() {
+        append(TraceRecord::dealloc, 0, 0, 0);
+    }
+
+    void on_rollback(std::size_t allocation_count) {
+        append(TraceRecord::rollback, allocation_count, 0, 0);
+    }
+
+    void on_reset() {
+        append(TraceRecord::reset, 0, 0, 0);
+    }
+
+    void to_json(std::ostream& out) const {
+        out << "{\"records\": " << trace.size() << ", \"tags\": " << tag_names.size() - 1 << "}";
+    }
+
+    // Function to reserve room for count records, so recording does not reallocate while measured code runs
+    void reserve_records(std::size_t count) {
+        trace.reserve(count);
+    }
+
+    const std::vector<TraceRecord>& records() const { return trace; }
+
+    // Function to write the trace recorded so far to path; returns false if the file cannot be written
+    bool save(const char* path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        TraceHeader header;
+        std::memcpy(header.magic, trace_magic, sizeof(header.magic));
+        header.version = trace_version;
+        header.tag_count = static_cast<std::uint32_t>(tag_names.size());
+        header.record_count = trace.size();
+        header.heap_size = heap_size;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const std::string& name : tag_names) {
+            std::uint16_t length = static_cast<std::uint16_t>(name.size());
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(name.data(), length);
+        }
+        file.write(reinterpret_cast<const char*>(trace.data()), static_cast<std::streamsize>(trace.size() * sizeof(TraceRecord)));
+        return static_cast<bool>(file);
+    }
+
+private:
+    std::string output_path;                     // File written on destruction
+    std::size_t heap_size;                       // Heap size of the recorded allocator
+    std::vector<TraceRecord> trace;              // Recorded events
+    std::vector<std::string> tag_names;          // Tag table, index = tag id
+    std::map<std::string, std::uint16_t> tag_ids; // Tag name to id
+    const char* last_tag = nullptr;              // Last tag pointer seen, to skip the map lookup for repeated call sites
+    std::uint16_t last_tag_id = 0;               // Id of last_tag
+    std::chrono::steady_clock::time_point last_event; // Time of the previous event
+    std::size_t pending = no_pending;            // First request record still waiting for on_alloc or on_failure
+
+    static constexpr std::size_t no_pending = static_cast<std::size_t>(-1);
+
+    static std::uint8_t log2(std::size_t alignment) {
+        std::uint8_t alignment_log2 = 0;
+        while (alignment > 1) {
+            alignment >>= 1;
+            alignment_log2++;
+        }
+        return alignment_log2;
+    }
+
+    void append(TraceRecord::Kind kind, std::uint64_t value, std::uint8_t alignment_log2, std::uint16_t tag) {
+        auto now = std::chrono::steady_clock::now();
+        auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_event).count();
+        last_event = now;
+        TraceRecord record;
+        record.value = value;
+        record.delta_ns = delta > 0xFFFFFFFFll ? 0xFFFFFFFFu : static_cast<std::uint32_t>(delta);
+        record.tag = tag;
+        record.alignment_log2 = alignment_log2;
+        record.kind = kind;
+        trace.push_back(record);
+    }
+
+    // Function to get the id of a tag, adding it to the table on first use (tags past the 65534th share id 65534)
+    std::uint16_t tag_id(const char* tag) {
+        if (tag == nullptr) {
+            return 0;
+        }
+        if (tag == last_tag) {
+            return last_tag_id;
+        }
+        auto found = tag_ids.find(tag);
+        std::uint16_t id;
+        if (found != tag_ids.end()) {
+            id = found->second;
+        } else if (tag_names.size() < 0xFFFF) {
+            id = static_cast<std::uint16_t>(tag_names.size());
+            tag_names.push_back(tag);
+            tag_ids[tag] = id;
+        } else {
+            id = 0xFFFE;
+        }
+        last_tag = tag;
+        last_tag_id = id;
+        return id;
+    }
+};
+
+// Function to load a trace file written by TraceRecorder; returns false if it is missing, truncated or not a trace.
+// Version 1 files have no resize or move records and read unchanged.
+inline bool read_trace(const char* path, Trace& trace) {
+    std::ifstream file(path, std::ios::binary);
+    TraceHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, trace_magic, sizeof(header.magic)) != 0 || header.version == 0 ||
+        header.version > trace_version) {
+        return false;
+    }
+    trace.heap_size = static_cast<std::size_t>(header.heap_size);
+    trace.tags.clear();
+    for (std::uint32_t i = 0; i < header.tag_count; ++i) {
+        std::uint16_t length = 0;
+        if (!file.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+            return false;
+        }
+        std::string name(length, '\0');
+        if (!file.read(&name[0], length)) {
+            return false;
+        }
+        trace.tags.push_back(name);
+    }
+    // Check the count against the bytes left before resizing, so a corrupt header cannot ask for gigabytes
+    std::streamoff records_start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::uint64_t bytes_left = static_cast<std::uint64_t>(file.tellg() - records_start);
+    file.seekg(records_start);
+    if (!file || header.record_count > bytes_left / sizeof(TraceRecord)) {
+        return false;
+    }
+    trace.records.resize(static_cast<std::size_t>(header.record_count));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(trace.records.data()),
+                                       static_cast<std::streamsize>(trace.records.size() * sizeof(TraceRecord))));
+}
+
+// Replays a trace against an allocator with alloc_bytes(size, alignment),
+// resize_last(ptr, old_size, new_size, alignment), dealloc(), mark() and rollback(marker).
+//
+// Traces store the allocation count after a rollback, not the marker itself,
+// so the constructor finds the allocation each rollback returns to and marks
+// the allocator just before it during the replay. Failed requests are skipped
+// because they did not change the recorded allocator. A reset rolls the
+// replay back to where it started, so the two allocators agree again even if
+// their allocation counts drifted. Resizes are replayed on the replay's most
+// recent block; a move does not say which block was copied or how big it was,
+// so the replay grows a scratch buffer one byte short of the new size, which
+// takes the same copy path and leaves the allocation count unchanged. Timing gaps are not reproduced;
+// the replay issues requests back to back.
+class TraceReplayer {
+public:
+    // One step of the replay
+    struct Op {
+        enum Kind : std::uint8_t { alloc, dealloc, rollback, resize, move, reset } kind;
+        std::uint8_t alignment_log2;  // alloc, resize, move: log2 of the alignment
+        std::uint32_t marker;         // alloc: marker slot to fill first (no_marker if none); rollback: slot to roll back to
+        std::uint64_t size;           // alloc: bytes; resize, move: new size
+    };
+
+    static constexpr std::uint32_t no_marker = 0xFFFFFFFFu;
+
+    // Constructor: Compiles the trace into replay steps
+    explicit TraceReplayer(const Trace& trace)
+        : marker_count(0), peak_requested(0), total_allocations(0), max_blocks(0), max_move(0) {
+        std::vector<std::size_t> live;   // Op index of the allocation at each allocation-count level
+        std::uint64_t requested = 0;
+        std::vector<std::uint64_t> requested_at; // Bytes requested before each live allocation
+        std::vector<std::uint64_t> blocks;       // Sizes of the blocks in the arena, newest last
+        std::vector<std::size_t> blocks_at;      // Blocks before each live allocation
+        for (const TraceRecord& record : trace.records) {
+            if (record.kind == TraceRecord::alloc) {
+                live.push_back(ops.size());
+                requested_at.push_back(requested);
+                blocks_at.push_back(blocks.size());
+                ops.push_back(Op{Op::alloc, record.alignment_log2, no_marker, record.value});
+                total_allocations++;
+                add_block(blocks, requested, record.value);
+            } else if (record.kind == TraceRecord::resize) {
+                if (blocks.empty()) {
+                    continue; // The tail was allocated before the trace started
+                }
+                requested = requested - blocks.back() + record.value;
+                blocks.back() = record.value;
+                peak_requested = std::max(peak_requested, requested);
+                ops.push_back(Op{Op::resize, record.alignment_log2, no_marker, record.value});
+            } else if (record.kind == TraceRecord::move) {
+                max_move = std::max(max_move, record.value);
+                ops.push_back(Op{Op::move, record.alignment_log2, no_marker, record.value});
+                add_block(blocks, requested, record.value);
+            } else if (record.kind == TraceRecord::dealloc) {
+                ops.push_back(Op{Op::dealloc, 0, no_marker, 0});
+                if (!live.empty()) {
+                    live.pop_back();
+                    requested_at.pop_back();
+                    blocks_at.pop_back();
+                }
+            } else if (record.kind == TraceRecord::reset) {
+                ops.push_back(Op{Op::reset, 0, no_marker, 0});
+                requested = 0;
+                live.clear();
+                requested_at.clear();
+                blocks.clear();
+                blocks_at.clear();
+            } else if (record.kind == TraceRecord::rollback) {
+                std::size_t count = static_cast<std::size_t>(record.value);
+                if (count >= live.size()) {
+                    continue; // Nothing allocated since the marker
+                }
+                Op& target = ops[live[count]];
+                if (target.marker == no_marker) {
+                    target.marker = marker_count++;
+                }
+                ops.push_back(Op{Op::rollback, 0, target.marker, 0});
+                requested = requested_at[count];
+                blocks.resize(blocks_at[count]);
+                live.resize(count);
+                requested_at.resize(count);
+                blocks_at.resize(count);
+            }
+        }
+    }
+
+    // Template function to replay every step once; returns the number of successful allocations.
+    // The allocator is rolled back to where it started afterwards, so the replay is repeatable.
+    template <typename Allocator>
+    std::size_t run(Allocator& allocator) const {
+        struct Block {
+            void* data;
+            std::size_t size;
+        };
+        std::vector<typename Allocator::Marker> markers(marker_count);
+        std::vector<std::size_t> depths(marker_count);  // Blocks when each marker was taken
+        std::vector<Block> blocks;                      // Blocks in the arena, newest last
+        blocks.reserve(max_blocks);
+        std::vector<char> scratch(static_cast<std::size_t>(max_move) + 1); // Source of moves, never null
+        typename Allocator::Marker start = allocator.mark();
+        std::size_t succeeded = 0;
+        for (const Op& op : ops) {
+            std::size_t size = static_cast<std::size_t>(op.size);
+            std::size_t alignment = std::size_t(1) << op.alignment_log2;
+            if (op.kind == Op::alloc) {
+                if (op.marker != no_marker) {
+                    markers[op.marker] = allocator.mark();
+                    depths[op.marker] = blocks.size();
+                }
+                void* block = allocator.alloc_bytes(size, alignment);
+                if (block != nullptr) {
+                    blocks.push_back(Block{block, size});
+                    succeeded++;
+                }
+            } else if (op.kind == Op::resize) {
+                if (!blocks.empty()) {
+                    void* block = allocator.resize_last(blocks.back().data, blocks.back().size, size, alignment);
+                    if (block != nullptr) {
+                        blocks.back() = Block{block, size};
+                    }
+                }
+            } else if (op.kind == Op::move) {
+                // A recorded move always grew its block, so size is at least 1
+                void* block = size == 0 ? nullptr : allocator.resize_last(static_cast<void*>(scratch.data()), size - 1, size, alignment);
+                if (block != nullptr) {
+                    blocks.push_back(Block{block, size});
+                }
+            } else if (op.kind == Op::dealloc) {
+                allocator.dealloc();
+            } else if (op.kind == Op::reset) {
+                allocator.rollback(start);
+                blocks.clear();
+            } else {
+                allocator.rollback(markers[op.marker]);
+                blocks.resize(depths[op.marker]);
+            }
+        }
+        allocator.rollback(start);
+        return succeeded;
+    }
+
+    const std::vector<Op>& steps() const { return ops; }
+    std::size_t allocations() const { return total_allocations; }        // Allocations issued per run
+    std::uint64_t peak_bytes() const { return peak_requested; }          // Most bytes requested and live at once, padding excluded
+
+private:
+    std::vector<Op> ops;            // Replay steps
+    std::uint32_t marker_count;     // Marker slots needed by rollback steps
+    std::uint64_t peak_requested;   // Most bytes live at once
+    std::size_t total_allocations;  // Alloc steps
+    std::size_t max_blocks;         // Most blocks in the arena at once
+    std::uint64_t max_move;         // Largest move, the size of the scratch buffer
+
+    // Function to account for a new block of size bytes while compiling
+    void add_block(std::vector<std::uint64_t>& blocks, std::uint64_t& requested, std::uint64_t size) {
+        blocks.push_back(size);
+        requested += size;
+        peak_requested = std::max(peak_requested, requested);
+        max_blocks = std::max(max_blocks, blocks.size());
+    }
+};
+
+#endif // ALLOCATIONTRACE_HPP
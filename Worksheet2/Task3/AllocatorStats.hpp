@@ -0,0 +1,182 @@
+#ifndef ALLOCATORSTATS_HPP
+#define ALLOCATORSTATS_HPP
+
+#include <cstddef>  // For size_t
+#include <iostream> // For DebugLog messages
+#include <map>      // For per-tag statistics
+#include <ostream>  // For JSON output
+#include <string>   // For tag names
+
+// Statistics policies for the bump allocators.
+//
+// The allocator calls the hooks below while holding its lock: on_request for
+// every allocation attempt (with its alignment), then on_alloc or on_failure;
+// on_resize for every resize_last() or try_extend() that changed the heap
+// (moved is true when the block was copied to a new place; used is the heap in
+// use afterwards, since a resize is not a new allocation), on_dealloc for every
+// dealloc(), on_rollback with the allocation count left after a rollback(),
+// and on_reset when the heap returns to empty. NoStats has
+// empty inline hooks, so an allocator built with it compiles to exactly the
+// same hot path as one without instrumentation. AllocationStats records
+// everything needed to size an arena from real data and can dump it as JSON.
+
+// Statistics policy that records nothing (the default)
+struct NoStats {
+    void on_create(std::size_t) {}
+    void on_destroy(std::size_t) {}
+    void on_request(std::size_t, std::size_t, const char*) {}
+    void on_alloc(std::size_t, std::size_t, std::size_t, const char*) {}
+    void on_failure(std::size_t, const char*) {}
+    void on_resize(std::size_t, std::size_t, std::size_t, bool, std::size_t, const char*) {}
+    void on_dealloc() {}
+    void on_rollback(std::size_t) {}
+    void on_reset() {}
+    void to_json(std::ostream& out) const { out << "{}"; }
+};
+
+// Statistics policy that records usage, padding, a size histogram and per-tag totals
+class AllocationStats {
+public:
+    static constexpr std::size_t histogram_buckets = 32; // Bucket i holds sizes in [2^(i-1), 2^i)
+
+    void on_create(std::size_t) {}
+    void on_destroy(std::size_t) {}
+    void on_request(std::size_t, std::size_t, const char*) {}
+    void on_dealloc() {}
+    void on_rollback(std::size_t) {}
+
+    // Hook: a block was resized and used heap bytes are now in use; it stays one allocation
+    void on_resize(std::size_t, std::size_t, std::size_t, bool, std::size_t used, const char*) {
+        if (used > high_water_mark) {
+            high_water_mark = used;
+        }
+    }
+
+    // Hook: an allocation of size bytes succeeded after padding bytes of alignment; used is the heap in use afterwards
+    void on_alloc(std::size_t size, std::size_t padding, std::size_t used, const char* tag) {
+        allocations++;
+        bytes_allocated += size;
+        padding_bytes += padding;
+        if (used > high_water_mark) {
+            high_water_mark = used;
+        }
+        size_histogram[bucket(size)]++;
+        if (tag != nullptr) {
+            TagStats& tag_stats = tags[tag];
+            tag_stats.allocations++;
+            tag_stats.bytes += size;
+        }
+    }
+
+    // Hook: an allocation of size bytes did not fit
+    void on_failure(std::size_t /*size*/, const char* tag) {
+        failed_allocations++;
+        if (tag != nullptr) {
+            tags[tag].failures++;
+        }
+    }
+
+    // Hook: the allocator returned to empty
+    void on_reset() {
+        resets++;
+    }
+
+    std::size_t allocations = 0;        // Successful allocations
+    std::size_t bytes_allocated = 0;    // Bytes requested by successful allocations
+    std::size_t padding_bytes = 0;      // Bytes lost to alignment padding
+    std::size_t high_water_mark = 0;    // Most heap bytes ever in use at once
+    std::size_t failed_allocations = 0; // Allocations that did not fit
+    std::size_t resets = 0;             // Times the allocator returned to empty
+    std::size_t size_histogram[histogram_buckets] = {}; // Allocation sizes by power of two
+
+    // Function to write every statistic as a JSON object
+    void to_json(std::ostream& out) const {
+        out << "{\"allocations\": " << allocations
+            << ", \"bytes_allocated\": " << bytes_allocated
+            << ", \"padding_bytes\": " << padding_bytes
+            << ", \"high_water_mark\": " << high_water_mark
+            << ", \"failed_allocations\": " << failed_allocations
+            << ", \"resets\": " << resets
+            << ", \"size_histogram\": [";
+        for (std::size_t i = 0; i < histogram_buckets; ++i) {
+            out << (i ? ", " : "") << size_histogram[i];
+        }
+        out << "], \"tags\": {";
+        bool first = true;
+        for (const auto& entry : tags) {
+            out << (first ? "" : ", ") << "\"" << entry.first << "\": {\"allocations\": " << entry.second.allocations
+                << ", \"bytes\": " << entry.second.bytes << ", \"failures\": " << entry.second.failures << "}";
+            first = false;
+        }
+        out << "}}";
+    }
+
+private:
+    struct TagStats {
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        std::size_t failures = 0;
+    };
+    std::map<std::string, TagStats> tags; // Totals per call-site tag
+
+    // Function to map a size to its histogram bucket (bit width of the size)
+    static std::size_t bucket(std::size_t size) {
+        std::size_t index = 0;
+        while (size != 0 && index < histogram_buckets - 1) {
+            size >>= 1;
+            index++;
+        }
+        return index;
+    }
+};
+
+// Statistics policy that prints the classic debug messages to std::cout.
+// The Task1 allocator prints by default, the Task2 allocator only when its
+// debug flag is set; DefaultOn picks which, and a bool converts to the policy
+// so BumpAllocator(size, debug) keeps working.
+template <bool DefaultOn>
+struct DebugLog {
+    DebugLog(bool enabled = DefaultOn) : enabled(enabled) {}
+
+    void on_create(std::size_t heap_size) {
+        if (enabled) {
+            std::cout << "BumpAllocator created with " << heap_size << " bytes." << std::endl;
+        }
+    }
+
+    void on_destroy(std::size_t total_allocations) {
+        if (enabled) {
+            std::cout << "BumpAllocator destroyed." << std::endl;
+            std::cout << "Total allocations made: " << total_allocations << std::endl;
+        }
+    }
+
+    void on_request(std::size_t, std::size_t, const char*) {}
+    void on_resize(std::size_t, std::size_t, std::size_t, bool, std::size_t, const char*) {}
+    void on_dealloc() {}
+    void on_rollback(std::size_t) {}
+
+    void on_alloc(std::size_t size, std::size_t, std::size_t, const char*) {
+        if (enabled) {
+            std::cout << "Allocated " << size << " bytes." << std::endl;
+        }
+    }
+
+    void on_failure(std::size_t, const char*) {
+        if (enabled) {
+            std::cout << "Failed to allocate memory. Not enough space!" << std::endl;
+        }
+    }
+
+    void on_reset() {
+        if (enabled) {
+            std::cout << "Allocator reset." << std::endl;
+        }
+    }
+
+    void to_json(std::ostream& out) const { out << "{}"; }
+
+    bool enabled; // Flag to enable/disable debug output
+};
+
+#endif // ALLOCATORSTATS_HPP
@@ -0,0 +1,117 @@
+#ifndef ARENABUFFER_HPP
+#define ARENABUFFER_HPP
+
+#include <cstddef>      // For size_t
+#include <type_traits>  // For std::is_trivially_copyable
+
+// Growable array of trivially copyable T that lives in a bump arena.
+//
+// The buffer doubles its capacity through the arena's resize_last. Only an
+// Upwards arena grows it in place: while the buffer is the most recent
+// allocation, growing just moves the bump pointer and nothing is copied. A
+// Downwards arena grows the block at its start, so every grow memmoves the
+// contents, like a vector's copy but without new space. Once something else
+// was allocated after the buffer, a grow falls back to allocate-and-copy. The buffer counts as one allocation in the
+// arena; its memory comes back with the arena's dealloc() or rollback(), not
+// with the buffer's destructor. Functions that need memory return false when
+// the arena is full and leave the buffer unchanged.
+template <typename T, typename Allocator>
+class ArenaBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "ArenaBuffer moves its elements with memcpy");
+
+public:
+    // Constructor: Empty buffer that will allocate from arena_allocator
+    explicit ArenaBuffer(Allocator& arena_allocator)
+        : arena(arena_allocator), elements(nullptr), element_count(0), element_capacity(0) {}
+
+    ArenaBuffer(const ArenaBuffer&) = delete;
+    ArenaBuffer& operator=(const ArenaBuffer&) = delete;
+
+    // Function to make room for at least capacity elements
+    bool reserve(std::size_t capacity) {
+        if (capacity <= element_capacity) {
+            return true;
+        }
+        T* resized = arena.template resize_last<T>(elements, element_capacity, capacity);
+        if (resized == nullptr) {
+            return false; // Arena is out of memory
+        }
+        elements = resized;
+        element_capacity = capacity;
+        return true;
+    }
+
+    // Function to append one element, doubling the capacity when full
+    bool push_back(const T& value) {
+        if (element_count == element_capacity && !reserve(grown_capacity(element_count + 1))) {
+            return false;
+        }
+        elements[element_count++] = value;
+        return true;
+    }
+
+    // Function to append count elements
+    bool append(const T* values, std::size_t count) {
+        if (element_count + count > element_capacity && !reserve(grown_capacity(element_count + count))) {
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            elements[element_count++] = values[i];
+        }
+        return true;
+    }
+
+    // Function to give unused capacity back to the arena. Only the tail buffer can do
+    // that; any other buffer keeps its capacity, since the arena could not reuse it
+    bool shrink_to_fit() {
+        if (element_count == element_capacity || element_count == 0) {
+            return true;
+        }
+        std::size_t remaining = arena.remaining_memory();
+        T* resized = arena.template resize_last<T>(elements, element_capacity, element_count);
+        if (resized == nullptr) {
+            return false;
+        }
+        if (arena.remaining_memory() != remaining) {
+            elements = resized;
+            element_capacity = element_count;
+        }
+        return true;
+    }
+
+    // Function to drop every element but keep the capacity
+    void clear() {
+        element_count = 0;
+    }
+
+    T& operator[](std::size_t index) { return elements[index]; }
+    const T& operator[](std::size_t index) const { return elements[index]; }
+
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+    T* begin() { return elements; }
+    T* end() { return elements + element_count; }
+
+    std::size_t size() const { return element_count; }
+    std::size_t capacity() const { return element_capacity; }
+    bool empty() const { return element_count == 0; }
+
+private:
+    static constexpr std::size_t initial_capacity = 16; // First allocation, in elements
+
+    Allocator& arena;               // Bump allocator the elements live in
+    T* elements;                    // First element (nullptr until the first reserve)
+    std::size_t element_count;      // Elements in use
+    std::size_t element_capacity;   // Elements allocated
+
+    // Function to pick the next capacity: double until at least required
+    std::size_t grown_capacity(std::size_t required) const {
+        std::size_t capacity = element_capacity ? element_capacity * 2 : initial_capacity;
+        while (capacity < required) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+};
+
+#endif // ARENABUFFER_HPP
@@ -0,0 +1,189 @@
+#ifndef ARENASNAPSHOT_HPP
+#define ARENASNAPSHOT_HPP
+
+#include <cstddef>    // For size_t
+#include <cstdint>    // For fixed-width header fields and uintptr_t
+#include <cstring>    // For std::memcmp and std::memcpy
+#include <fcntl.h>    // For open
+#include <fstream>    // For writing snapshot files
+#include <sys/mman.h> // For mmap and munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+#include <utility>    // For std::swap
+#include "OffsetPtr.hpp" // For self-relative pointers inside snapshots
+
+// Persistent arena snapshots.
+//
+// save_snapshot writes the used region of a bump allocator to a file behind a
+// SnapshotHeader (magic, version, size, root offset and checksum).
+// MappedSnapshot maps that file back read-only with one mmap call, so loading
+// a large lookup structure is a page-in instead of a rebuild.
+//
+// The structures inside the arena must not contain raw pointers. Link them
+// with offset_ptr, which stays valid at any base address, and give them no
+// virtual functions. The payload is placed in the file so that it keeps its
+// address modulo snapshot_alignment, so objects aligned to up to 64 bytes
+// stay aligned after mapping. Snapshots use the byte order and type layout of
+// the machine and compiler that wrote them.
+
+constexpr std::uint32_t snapshot_version = 1;   // Bumped when the file layout changes
+constexpr std::size_t snapshot_alignment = 64;   // Largest alignment preserved by a snapshot
+constexpr char snapshot_magic[8] = {'B', 'U', 'M', 'P', 'S', 'N', 'A', 'P'};
+
+// File header written in front of the arena bytes
+struct SnapshotHeader {
+    char magic[8];                // snapshot_magic
+    std::uint32_t version;        // snapshot_version of the writer
+    std::uint32_t payload_offset; // File offset of the arena bytes
+    std::uint64_t payload_size;   // Number of arena bytes
+    std::uint64_t root_offset;    // Root object, in bytes from the start of the payload
+    std::uint64_t checksum;       // snapshot_checksum of the payload
+};
+
+// Function to compute the FNV-1a hash used as the payload checksum
+inline std::uint64_t snapshot_checksum(const char* data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Function to write the used region of allocator to path, with root as the entry point.
+// The allocator must not be used by other threads while it is saved.
+// Returns false if root is not inside the used region or the file cannot be written.
+template <typename Allocator, typename T>
+bool save_snapshot(const Allocator& allocator, const T* root, const char* path) {
+    const char* payload = allocator.used_data();
+    std::size_t payload_size = allocator.used_memory();
+    const char* root_bytes = reinterpret_cast<const char*>(root);
+    if (root_bytes < payload || root_bytes + sizeof(T) > payload + payload_size) {
+        return false; // The root must live in the snapshot
+    }
+
+    // Keep the payload's address modulo snapshot_alignment so alignment survives the round trip
+    std::size_t header_bytes = (sizeof(SnapshotHeader) + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+    std::size_t shift = reinterpret_cast<std::uintptr_t>(payload) & (snapshot_alignment - 1);
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version = snapshot_version;
+    header.payload_offset = static_cast<std::uint32_t>(header_bytes + shift);
+    header.payload_size = payload_size;
+    header.root_offset = static_cast<std::uint64_t>(root_bytes - payload);
+    header.checksum = snapshot_checksum(payload, payload_size);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const char padding[2 * snapshot_alignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding, header.payload_offset - sizeof(header));
+    file.write(payload, payload_size);
+    return static_cast<bool>(file.flush());
+}
+
+// Read-only mapping of a snapshot file.
+//
+// Construction never throws: if the file cannot be mapped or its header does
+// not match, valid() is false, error() says why and root<T>() returns nullptr.
+// Checksum verification reads every page of the payload, so pass
+// verify_checksum = false for an O(1) load of a trusted file.
+class MappedSnapshot {
+public:
+    // Constructor: Maps the snapshot at path
+    explicit MappedSnapshot(const char* path, bool verify_checksum = true)
+        : mapping(nullptr), mapping_size(0), header(nullptr), failure(nullptr) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            failure = "cannot open snapshot file";
+            return;
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(SnapshotHeader)) {
+            close(fd);
+            failure = "snapshot file is truncated";
+            return;
+        }
+        mapping_size = static_cast<std::size_t>(file_stat.st_size);
+        void* mapped = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping keeps the file alive
+        if (mapped == MAP_FAILED) {
+            mapping_size = 0;
+            failure = "cannot map snapshot file";
+            return;
+        }
+        mapping = static_cast<char*>(mapped);
+        failure = check(verify_checksum);
+        if (failure == nullptr) {
+            header = reinterpret_cast<const SnapshotHeader*>(mapping);
+        }
+    }
+
+    // Destructor: Unmaps the file
+    ~MappedSnapshot() {
+        if (mapping != nullptr) {
+            munmap(mapping, mapping_size);
+        }
+    }
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    MappedSnapshot(MappedSnapshot&& other) noexcept
+        : mapping(nullptr), mapping_size(0), header(nullptr), failure(nullptr) {
+        swap(other);
+    }
+
+    MappedSnapshot& operator=(MappedSnapshot&& other) noexcept {
+        MappedSnapshot(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    bool valid() const { return header != nullptr; }   // Whether the snapshot mapped and checked out
+    const char* error() const { return failure; }      // Why the snapshot is invalid, nullptr if valid
+
+    // Template function to get the root object passed to save_snapshot (nullptr if invalid).
+    // The memory is read-only: writing through it faults.
+    template <typename T>
+    const T* root() const {
+        return valid() ? reinterpret_cast<const T*>(data() + header->root_offset) : nullptr;
+    }
+
+    const char* data() const { return valid() ? mapping + header->payload_offset : nullptr; }    // Start of the arena bytes
+    std::size_t size() const { return valid() ? static_cast<std::size_t>(header->payload_size) : 0; } // Number of arena bytes
+
+private:
+    char* mapping;                  // Whole file, mapped read-only
+    std::size_t mapping_size;       // Size of the mapping
+    const SnapshotHeader* header;   // Header at the start of the mapping, nullptr if invalid
+    const char* failure;            // Reason the snapshot is invalid
+
+    // Function to validate the header (and optionally the checksum); returns an error or nullptr
+    const char* check(bool verify_checksum) const {
+        const SnapshotHeader* candidate = reinterpret_cast<const SnapshotHeader*>(mapping);
+        if (std::memcmp(candidate->magic, snapshot_magic, sizeof(snapshot_magic)) != 0) {
+            return "not a snapshot file";
+        }
+        if (candidate->version != snapshot_version) {
+            return "unsupported snapshot version";
+        }
+        if (candidate->payload_offset > mapping_size || candidate->payload_size > mapping_size - candidate->payload_offset ||
+            candidate->root_offset >= candidate->payload_size) {
+            return "snapshot file is truncated";
+        }
+        if (verify_checksum &&
+            snapshot_checksum(mapping + candidate->payload_offset, candidate->payload_size) != candidate->checksum) {
+            return "snapshot checksum mismatch";
+        }
+        return nullptr;
+    }
+
+    void swap(MappedSnapshot& other) noexcept {
+        std::swap(mapping, other.mapping);
+        std::swap(mapping_size, other.mapping_size);
+        std::swap(header, other.header);
+        std::swap(failure, other.failure);
+    }
+};
+
+#endif // ARENASNAPSHOT_HPP
@@ -0,0 +1,548 @@
+#ifndef BASICBUMPALLOCATOR_HPP
+#define BASICBUMPALLOCATOR_HPP
+
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uintptr_t
+#include <cstring>  // For std::memcpy and std::memmove in resize_last
+#include <mutex>    // For std::mutex and std::lock_guard
+#include <new>      // For placement new
+#include <tuple>    // For the typed alloc_batch result
+#include <type_traits> // For std::is_trivially_copyable
+#include <utility>  // For std::move, std::swap and std::forward
+#include "DestructorRegistry.hpp" // For destructors of objects built with create()
+#include "AllocatorStats.hpp"     // For NoStats, AllocationStats and DebugLog
+
+// Policy-based bump allocator.
+//
+// BumpAllocator (Task1/Task2), BumpAllocatorUpwards and BumpAllocatorDownwards
+// used to be near-identical copies that differed only in direction, debug
+// printing and locking. They are now aliases of this one template:
+//
+//   Direction    - Upwards or Downwards: which end the bump pointer starts at
+//   LockPolicy   - MutexLock for thread-safety, NoLock for single-threaded use
+//   StatsPolicy  - NoStats, AllocationStats or DebugLog (see AllocatorStats.hpp)
+//   BackingStore - NewHeap, MmapHeap or HeapStore (see HeapStore.hpp)
+//
+// Every policy call is a static or inline member, so each combination compiles
+// into its own hot path; Upwards + NoLock + NoStats reduces to an align, a
+// compare and a pointer add.
+
+// Direction policy: bump from the start of the heap towards the end
+struct Upwards {
+    static constexpr bool resizes_in_place = true; // resize() never moves the block
+
+    static char* start(char* heap, char*) { return heap; }
+    static char* end(char*, char* heap_end) { return heap_end; }
+
+    // Function to carve size bytes from next; nullptr if it does not fit
+    static char* bump(char*& next, char*, char* heap_end, std::size_t size, std::size_t alignment) {
+        // Align the pointer by moving it forward
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(next) & (alignment - 1);
+        char* aligned_ptr = misalignment ? next + (alignment - misalignment) : next;
+
+        // Check if the aligned pointer plus required size is within bounds
+        if (aligned_ptr <= heap_end && size <= static_cast<std::size_t>(heap_end - aligned_ptr)) {
+            next = aligned_ptr + size; // Move the bump pointer forward
+            return aligned_ptr;
+        }
+        return nullptr;
+    }
+
+    // Function to resize the tail block at ptr in place; nullptr if ptr is not the tail or the new size does not fit.
+    // The block keeps its start and grows or shrinks at its end, so nothing moves.
+    static char* resize(char*& next, char*, char* heap_end, char* ptr, std::size_t old_size, std::size_t new_size, std::size_t) {
+        if (ptr + old_size != next || new_size > static_cast<std::size_t>(heap_end - ptr)) {
+            return nullptr;
+        }
+        next = ptr + new_size; // Move the end of the block
+        return ptr;
+    }
+
+    static char* used_start(char*, char* heap) { return heap; }
+    static std::size_t used(char* next, char* heap, char*) { return next - heap; }
+    static std::size_t remaining(char* next, char*, char* heap_end) { return heap_end - next; }
+};
+
+// Direction policy: bump from the end of the heap towards the start
+struct Downwards {
+    static constexpr bool resizes_in_place = false; // resize() moves the block start
+
+    static char* start(char*, char* heap_end) { return heap_end; }
+    static char* end(char* heap, char*) { return heap; }
+
+    // Function to carve size bytes below next; nullptr if it does not fit
+    static char* bump(char*& next, char* heap, char*, std::size_t size, std::size_t alignment) {
+        // Requests larger than the free space fail up front
+        if (size > static_cast<std::size_t>(next - heap)) {
+            return nullptr;
+        }
+
+        // Align the pointer by moving it backward
+        char* aligned_ptr = next - size;
+        aligned_ptr -= reinterpret_cast<std::uintptr_t>(aligned_ptr) & (alignment - 1);
+
+        // Check if the aligned pointer is within bounds
+        if (aligned_ptr >= heap) {
+            next = aligned_ptr; // Update the bump pointer
+            return aligned_ptr;
+        }
+        return nullptr;
+    }
+
+    // Function to resize the tail block at ptr; nullptr if ptr is not the tail or the new size does not fit.
+    // The block keeps its end and grows or shrinks at its start, so the contents are moved to the new start.
+    static char* resize(char*& next, char* heap, char*, char* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment) {
+        if (ptr != next) {
+            return nullptr;
+        }
+        char* block_end = ptr + old_size;
+        if (new_size > static_cast<std::size_t>(block_end - heap)) {
+            return nullptr;
+        }
+
+        // Align the new start by moving it backward, as bump() does
+        char* new_ptr = block_end - new_size;
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(new_ptr) & (alignment - 1);
+        if (misalignment > static_cast<std::size_t>(new_ptr - heap)) {
+            return nullptr;
+        }
+        new_ptr -= misalignment;
+
+        std::memmove(new_ptr, ptr, old_size < new_size ? old_size : new_size); // Ranges may overlap
+        next = new_ptr;
+        return new_ptr;
+    }
+
+    static char* used_start(char* next, char*) { return next; }
+    static std::size_t used(char* next, char*, char* heap_end) { return heap_end - next; }
+    static std::size_t remaining(char* next, char* heap, char*) { return next - heap; }
+};
+
+// Lock policy: std::mutex around every operation
+struct MutexLock {
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+    std::mutex mutex; // Mutex for thread-safety
+};
+
+// Lock policy: no locking, for allocators owned by a single thread
+struct NoLock {
+    void lock() {}
+    void unlock() {}
+};
+
+// Backing store that gets its heap from new char[]
+class NewHeap {
+public:
+    NewHeap() : heap(nullptr), heap_size(0) {} // Empty, owns nothing
+    explicit NewHeap(std::size_t size) : heap(new char[size]), heap_size(size) {}
+
+    ~NewHeap() {
+        delete[] heap; // Free the allocated heap memory
+    }
+
+    NewHeap(const NewHeap&) = delete;
+    NewHeap& operator=(const NewHeap&) = delete;
+
+    NewHeap(NewHeap&& other) noexcept : heap(other.heap), heap_size(other.heap_size) {
+        other.heap = nullptr;
+        other.heap_size = 0;
+    }
+
+    NewHeap& operator=(NewHeap&& other) noexcept {
+        std::swap(heap, other.heap);
+        std::swap(heap_size, other.heap_size);
+        return *this;
+    }
+
+    char* data() const { return heap; }
+    std::size_t size() const { return heap_size; }
+
+private:
+    char* heap;             // Pointer to the start of the heap
+    std::size_t heap_size;  // Size of the heap
+};
+
+// Base that holds the StatsPolicy. Deriving from it instead of storing a member lets the
+// empty-base optimisation give NoStats zero bytes; C++17 has no [[no_unique_address]].
+template <typename StatsPolicy>
+class StatsPolicyHolder : private StatsPolicy {
+protected:
+    explicit StatsPolicyHolder(StatsPolicy stats) : StatsPolicy(std::move(stats)) {}
+
+    StatsPolicy& statistics() { return *this; }
+    const StatsPolicy& statistics() const { return *this; }
+};
+
+template <typename Direction, typename LockPolicy = MutexLock, typename StatsPolicy = NoStats, typename BackingStore = NewHeap>
+class BasicBumpAllocator : private StatsPolicyHolder<StatsPolicy> {
+    using StatsPolicyHolder<StatsPolicy>::statistics; // Instrumentation hooks, empty for NoStats
+
+public:
+    // One raw request for alloc_batch
+    struct BatchRequest {
+        std::size_t size;       // Bytes requested
+        std::size_t alignment;  // Power-of-two alignment
+    };
+
+    // Saved allocator position, see mark() and rollback()
+    struct Marker {
+        char* position;               // Bump pointer when the marker was taken
+        std::size_t allocation_count; // Active allocations when the marker was taken
+        DestructorRegistry::Entry* destructors; // Newest destructor entry when the marker was taken
+    };
+
+    // Constructor: Initializes the allocator with a heap of the given size
+    BasicBumpAllocator(std::size_t heap_size, StatsPolicy stats = StatsPolicy())
+        : StatsPolicyHolder<StatsPolicy>(std::move(stats)), store(heap_size) {
+        init();
+    }
+
+    // Constructor: Uses an existing backing store (e.g. an MmapHeap) as the heap
+    BasicBumpAllocator(BackingStore backing_store, StatsPolicy stats = StatsPolicy())
+        : StatsPolicyHolder<StatsPolicy>(std::move(stats)), store(std::move(backing_store)) {
+        init();
+    }
+
+    // Destructor: Destroys live objects; the backing store frees the heap
+    ~BasicBumpAllocator() {
+        destructors.run_all(); // Destroy objects still alive in the arena
+        statistics().on_destroy(total_allocations);
+    }
+
+    BasicBumpAllocator(const BasicBumpAllocator&) = delete;
+    BasicBumpAllocator& operator=(const BasicBumpAllocator&) = delete;
+
+    static constexpr std::size_t cache_line_size = 64; // Granularity of isolated allocations
+
+    // Template function for memory allocation.
+    // Alignment may raise the alignment above alignof(T) at compile time, e.g. alloc<float, 64>(n).
+    template <typename T, std::size_t Alignment = alignof(T)>
+    T* alloc(std::size_t num_objects, const char* tag = nullptr) {
+        static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment must not be weaker than alignof(T)");
+        return static_cast<T*>(alloc_bytes(sizeof(T) * num_objects, Alignment, tag));
+    }
+
+    // Template function for memory allocation with a runtime alignment (e.g. 32 for AVX,
+    // 64 for AVX-512 or a cache line). With isolated set, the allocation starts on a cache
+    // line and is padded to whole cache lines, so no other allocation shares its lines.
+    // Returns nullptr if alignment is not a power of two.
+    template <typename T>
+    T* alloc_aligned(std::size_t num_objects, std::size_t alignment, bool isolated = false, const char* tag = nullptr) {
+        if (alignment < alignof(T)) {
+            alignment = alignof(T);
+        }
+        std::size_t required_size = sizeof(T) * num_objects;
+        if (isolated) {
+            if (alignment < cache_line_size) {
+                alignment = cache_line_size;
+            }
+            required_size = (required_size + cache_line_size - 1) / cache_line_size * cache_line_size;
+        }
+        return static_cast<T*>(alloc_bytes(required_size, alignment, tag));
+    }
+
+    // Template function to construct one object of type T in the arena.
+    // Its destructor runs when the allocator resets or rolls back past it.
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* block = nullptr;
+        Marker before;
+        char* after = nullptr;
+        T* object = reserve_objects<T>(1, block, before, after);
+        if (object == nullptr) {
+            return nullptr; // Return null pointer if allocation fails
+        }
+        try {
+            new (object) T(std::forward<Args>(args)...);
+        } catch (...) {
+            undo_allocation(before, after); // Give the allocation back before rethrowing
+            throw;
+        }
+        register_objects<T>(block, object, 1);
+        return object;
+    }
+
+    // Template function to construct num_objects objects of type T, each from the same arguments
+    template <typename T, typename... Args>
+    T* create_array(std::size_t num_objects, const Args&... args) {
+        void* block = nullptr;
+        Marker before;
+        char* after = nullptr;
+        T* objects = reserve_objects<T>(num_objects, block, before, after);
+        if (objects == nullptr) {
+            return nullptr; // Return null pointer if allocation fails
+        }
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < num_objects; ++constructed) {
+                new (objects + constructed) T(args...);
+            }
+        } catch (...) {
+            DestructorRegistry::destroy<T>(objects, constructed); // Undo the objects already built
+            undo_allocation(before, after);
+            throw;
+        }
+        register_objects<T>(block, objects, num_objects);
+        return objects;
+    }
+
+    // Function for raw memory allocation with an explicit power-of-two alignment
+    // (anything else fails with nullptr). tag optionally names the call site for AllocationStats.
+    void* alloc_bytes(std::size_t required_size, std::size_t alignment, const char* tag = nullptr) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        return allocate(required_size, alignment, tag);
+    }
+
+    // Function to resize a block from alloc_bytes (or start one when ptr is nullptr), like realloc.
+    // If ptr is the most recent allocation it is resized where it lies, without new space.
+    // Only Upwards does that in O(1): it moves the end of the block and keeps ptr. Downwards
+    // moves the start of the block and memmoves the contents with it, which is O(n) in the
+    // block size. Any other block keeps ptr when it shrinks (the freed bytes stay in the
+    // arena until reset) and is copied to a fresh allocation when it grows;
+    // the old copy stays in the arena until reset, and the move does not change the
+    // allocation count. Returns the new location, or nullptr (ptr untouched) if there is no room.
+    void* resize_last(void* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment, const char* tag = nullptr) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+
+        if (ptr == nullptr) {
+            return allocate(new_size, alignment, tag);
+        }
+        if (!valid_alignment(alignment)) {
+            statistics().on_failure(new_size, tag);
+            return nullptr;
+        }
+
+        char* resized = Direction::resize(next, heap, heap_end, static_cast<char*>(ptr), old_size, new_size, alignment);
+        if (resized != nullptr) {
+            statistics().on_resize(old_size, new_size, alignment, false, Direction::used(next, heap, heap_end), tag);
+            return resized;
+        }
+
+        // Not the tail: a shrink needs no memory, a grow allocates and copies
+        if (new_size <= old_size) {
+            return ptr; // The heap did not change, so there is nothing to report
+        }
+        char* copy = Direction::bump(next, heap, heap_end, new_size, alignment);
+        if (copy == nullptr) {
+            statistics().on_failure(new_size, tag);
+            return nullptr;
+        }
+        std::memcpy(copy, ptr, old_size); // The block moved; it is still one allocation
+        statistics().on_resize(old_size, new_size, alignment, true, Direction::used(next, heap, heap_end), tag);
+        return copy;
+    }
+
+    // Template function to resize an array of trivially copyable T, see resize_last above
+    template <typename T>
+    T* resize_last(T* ptr, std::size_t old_count, std::size_t new_count, const char* tag = nullptr) {
+        static_assert(std::is_trivially_copyable<T>::value, "resize_last moves objects with memcpy");
+        return static_cast<T*>(resize_last(static_cast<void*>(ptr), sizeof(T) * old_count, sizeof(T) * new_count, alignof(T), tag));
+    }
+
+    // Function to resize the most recent allocation only if it can keep its address.
+    // That is always the case for an Upwards tail that fits; a Downwards block grows at
+    // its start, so it can never be extended without moving and this returns false.
+    bool try_extend(void* ptr, std::size_t old_size, std::size_t new_size) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+
+        if (!Direction::resizes_in_place || ptr == nullptr ||
+            Direction::resize(next, heap, heap_end, static_cast<char*>(ptr), old_size, new_size, 1) == nullptr) {
+            return false;
+        }
+        statistics().on_resize(old_size, new_size, 1, false, Direction::used(next, heap, heap_end), nullptr);
+        return true;
+    }
+
+    // Function to satisfy several requests with one lock acquisition.
+    // The layout is computed on a local copy of the bump pointer and only
+    // committed if every request fits, so the batch succeeds or fails as a
+    // whole: on success results[i] receives the pointer for requests[i] and
+    // true is returned; on failure (no room or an invalid alignment) nothing is
+    // allocated and results are nullptr.
+    // Each request counts as one allocation for dealloc(); the StatsPolicy
+    // sees the batch as one allocation of the combined size.
+    bool alloc_batch(const BatchRequest* requests, std::size_t count, void** results, const char* tag = nullptr) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+
+        char* cursor = next;
+        std::size_t required_size = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            statistics().on_request(requests[i].size, requests[i].alignment, tag);
+            results[i] = !valid_alignment(requests[i].alignment) ? nullptr : Direction::bump(cursor, heap, heap_end, requests[i].size, requests[i].alignment);
+            required_size += requests[i].size;
+            if (results[i] == nullptr) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    results[j] = nullptr;
+                }
+                statistics().on_failure(required_size, tag);
+                return false; // Nothing was committed
+            }
+        }
+
+        std::size_t used_before = Direction::used(next, heap, heap_end);
+        next = cursor;            // Commit the whole batch at once
+        allocation_count += count;
+        total_allocations += count;
+        std::size_t used_after = Direction::used(next, heap, heap_end);
+        statistics().on_alloc(required_size, used_after - used_before - required_size, used_after, tag);
+        return true;
+    }
+
+    // Template function to allocate arrays of several types together, e.g.
+    //     auto [ids, weights] = allocator.alloc_batch<int, double>(100, 100);
+    // Returns a tuple of nullptrs if the batch does not fit.
+    template <typename... Ts>
+    std::tuple<Ts*...> alloc_batch(decltype(sizeof(Ts))... num_objects) {
+        BatchRequest requests[] = {BatchRequest{sizeof(Ts) * num_objects, alignof(Ts)}...};
+        void* results[sizeof...(Ts)];
+        alloc_batch(requests, sizeof...(Ts), results);
+        return unpack_batch<Ts...>(results, std::index_sequence_for<Ts...>());
+    }
+
+    // Function to deallocate memory (reset the allocator when all allocations are freed)
+    void dealloc() {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        release_one();
+    }
+
+    // Function to save the current position of the bump pointer
+    Marker mark() {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        return Marker{next, allocation_count, destructors.top()};
+    }
+
+    // Function to release everything allocated since the marker was taken, in O(1).
+    // Markers must be rolled back in LIFO order.
+    void rollback(const Marker& marker) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        destructors.run_until(marker.destructors);   // Destroy objects created after the marker
+        next = marker.position;                      // Move the bump pointer back
+        allocation_count = marker.allocation_count;  // Forget allocations made after the marker
+        statistics().on_rollback(allocation_count);
+    }
+
+    // Function to get the statistics recorded by the StatsPolicy (not synchronized with alloc)
+    const StatsPolicy& stats() const {
+        return statistics();
+    }
+
+    // Function to get the remaining memory available
+    std::size_t remaining_memory() const {
+        return Direction::remaining(next, heap, heap_end);
+    }
+
+    // Function to get the start of the contiguous region in use (see ArenaSnapshot.hpp)
+    const char* used_data() const {
+        return Direction::used_start(next, heap);
+    }
+
+    // Function to get the number of bytes in use, padding included
+    std::size_t used_memory() const {
+        return Direction::used(next, heap, heap_end);
+    }
+
+private:
+    BackingStore store;             // Owns the heap memory
+    char* heap;                     // Pointer to the start of the heap
+    char* heap_end;                 // Pointer to the end of the heap
+    char* next;                     // Bump pointer for the next allocation
+    std::size_t allocation_count;   // Number of active allocations
+    std::size_t total_allocations;  // Total number of allocations ever made
+    LockPolicy alloc_lock;          // Lock for thread-safety, empty for NoLock
+    DestructorRegistry destructors; // Objects built with create() that need destroying
+
+    // Function to bump required_size bytes; the caller holds the lock
+    void* allocate(std::size_t required_size, std::size_t alignment, const char* tag) {
+        statistics().on_request(required_size, alignment, tag);
+        if (!valid_alignment(alignment)) {
+            statistics().on_failure(required_size, tag);
+            return nullptr;
+        }
+
+        std::size_t used_before = Direction::used(next, heap, heap_end);
+        char* aligned_ptr = Direction::bump(next, heap, heap_end, required_size, alignment);
+        if (aligned_ptr != nullptr) {
+            allocation_count++;       // Increment the current allocation count
+            total_allocations++;      // Increment the total allocations count
+            std::size_t used_after = Direction::used(next, heap, heap_end);
+            statistics().on_alloc(required_size, used_after - used_before - required_size, used_after, tag);
+            return aligned_ptr; // Return aligned pointer
+        }
+
+        statistics().on_failure(required_size, tag);
+        return nullptr; // Return null pointer if allocation fails
+    }
+
+    void init() {
+        heap = store.data();                       // Use the backing store as the heap
+        heap_end = heap + store.size();            // Mark the end of the heap
+        next = Direction::start(heap, heap_end);   // Set the bump pointer to its starting end
+        allocation_count = 0;                      // Initialize allocation counter
+        total_allocations = 0;                     // Initialize total allocations counter
+        statistics().on_create(store.size());
+    }
+
+    // Function to check that an alignment is a non-zero power of two, as the mask arithmetic in bump() assumes
+    static bool valid_alignment(std::size_t alignment) {
+        return alignment != 0 && (alignment & (alignment - 1)) == 0;
+    }
+
+    template <typename... Ts, std::size_t... Is>
+    static std::tuple<Ts*...> unpack_batch(void** results, std::index_sequence<Is...>) {
+        return std::tuple<Ts*...>(static_cast<Ts*>(results[Is])...);
+    }
+
+    // Function to deallocate one allocation; the caller holds the lock
+    void release_one() {
+        statistics().on_dealloc();
+        if (allocation_count > 0) {
+            allocation_count--; // Decrease allocation count
+        }
+
+        // Reset the allocator if all allocations are deallocated
+        if (allocation_count == 0) {
+            destructors.run_all(); // Destroy every object built with create()
+            next = Direction::start(heap, heap_end);
+            statistics().on_reset();
+        }
+    }
+
+    // Template function to allocate a block for num_objects objects plus their destructor entry.
+    // before and after receive the allocator's position around the block, for undo_allocation.
+    template <typename T>
+    T* reserve_objects(std::size_t num_objects, void*& block, Marker& before, char*& after) {
+        std::size_t header = DestructorRegistry::header_size<T>();
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        before = Marker{next, allocation_count, destructors.top()};
+        block = allocate(header + sizeof(T) * num_objects, DestructorRegistry::block_alignment<T>(), nullptr);
+        after = next;
+        return block ? reinterpret_cast<T*>(static_cast<char*>(block) + header) : nullptr;
+    }
+
+    // Function to give back a block from reserve_objects whose constructor threw. If nothing
+    // was allocated since, the bump pointer returns to before the block, like a rollback;
+    // otherwise the block is only deallocated and its space waits for the reset.
+    void undo_allocation(const Marker& before, char* after) {
+        std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+        if (next != after) {
+            release_one();
+            return;
+        }
+        next = before.position;  // Reclaim the block and its padding
+        allocation_count--;
+        statistics().on_rollback(allocation_count);
+    }
+
+    // Template function to record the destructor entry; compiled out for trivially destructible types
+    template <typename T>
+    void register_objects(void* block, T* objects, std::size_t num_objects) {
+        if constexpr (DestructorRegistry::needs_entry<T>) {
+            std::lock_guard<LockPolicy> guard(alloc_lock); // Ensure thread-safety (no-op for NoLock)
+            destructors.record<T>(block, objects, num_objects);
+        }
+    }
+};
+
+#endif // BASICBUMPALLOCATOR_HPP
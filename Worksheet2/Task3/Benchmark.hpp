@@ -2,8 +2,20 @@
 #ifndef BENCHMARK_HPP
 #define BENCHMARK_HPP
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "PerfCounters.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 class Benchmark {
 public:
@@ -24,6 +36,240 @@ public:
         std::chrono::duration<double, std::nano> duration = end - start;
         return duration.count();  // Return duration in nanoseconds
     }
+
+    // Settings for run()
+    struct Options {
+        std::size_t warmup = 3;            // Untimed calls before measuring (warms caches, heap pages and branch predictors)
+        std::size_t samples = 31;          // Timed samples; each is the mean over iterations calls
+        double min_sample_ns = 200000;     // Calibrate iterations so one sample takes at least this long
+        std::size_t max_iterations = 1u << 20; // Upper bound for the calibration
+        bool use_tsc = false;              // Time with the CPU's time-stamp counter (cycles) instead of steady_clock (ns)
+        bool perf_counters = false;        // Also count hardware events (cycles, misses, ...) over the samples
+    };
+
+    // Per-call statistics over all samples
+    struct Stats {
+        std::size_t samples = 0;          // Number of samples
+        std::size_t iterations = 0;       // Calls per sample
+        double min = 0;                   // Fastest sample
+        double median = 0;                // Middle sample
+        double mean = 0;                  // Average sample
+        double p99 = 0;                   // 99th percentile sample
+        double stddev = 0;                // Standard deviation of the samples
+        const char* unit = "ns";          // "ns", or "cycles" with the TSC timer on x86
+        PerfCounters::Reading counters;   // Hardware events per call (valid only with Options::perf_counters)
+        const char* counter_error = nullptr; // Why no events were counted, if they were requested
+    };
+
+    // Function to keep value (and the work that produced it) from being optimized away
+    template <typename T>
+    static void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Function to make the compiler assume all memory was read and written here
+    static void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    static constexpr bool has_tsc = true;   // read_tsc counts cycles
+#else
+    static constexpr bool has_tsc = false;  // read_tsc falls back to nanoseconds
+#endif
+
+    // Function to read the cycle timer: the TSC on x86, steady_clock nanoseconds elsewhere
+    static std::uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Timer for single calls, with its own overhead calibrated away.
+    // time(histogram, func) records how long one func() took into histogram and returns
+    // its result, e.g. int* p = timer.time(alloc_latency, [&] { return allocator.alloc<int>(1); });
+    class LatencyTimer {
+    public:
+        // Constructor: Measures the cost of an empty timed region (median of many back-to-back reads)
+        explicit LatencyTimer(bool use_tsc = false) : use_tsc(use_tsc), overhead(0) {
+            LatencyHistogram empty;
+            for (int i = 0; i < 20000; ++i) {
+                std::uint64_t start = now();
+                clobber_memory();
+                empty.record(now() - start);
+            }
+            overhead = empty.percentile(50);
+        }
+
+        template <typename Func>
+        decltype(auto) time(LatencyHistogram& histogram, Func&& func) const {
+            if constexpr (std::is_void<decltype(func())>::value) {
+                std::uint64_t start = now();
+                func();
+                record(histogram, start, now());
+            } else {
+                std::uint64_t start = now();
+                auto result = func();
+                record(histogram, start, now());
+                return result;
+            }
+        }
+
+        std::uint64_t overhead_per_call() const { return overhead; }  // Subtracted from every sample
+        const char* unit() const { return use_tsc && has_tsc ? "cycles" : "ns"; }
+
+        // Function to read the clock this timer uses
+        std::uint64_t now() const {
+            if (use_tsc) {
+                return read_tsc();
+            }
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+    private:
+        bool use_tsc;            // TSC cycles instead of steady_clock nanoseconds
+        std::uint64_t overhead;  // Median cost of an empty timed region
+
+        void record(LatencyHistogram& histogram, std::uint64_t start, std::uint64_t end) const {
+            std::uint64_t elapsed = end - start;
+            histogram.record(elapsed > overhead ? elapsed - overhead : 0);
+        }
+    };
+
+    // Function to benchmark func(args...): warm up, calibrate the number of calls per
+    // sample, take options.samples samples and summarize the time per call.
+    // func must be repeatable, e.g. an allocator workload that ends with dealloc().
+    template <typename Func, typename... Args>
+    static Stats run(const Options& options, Func func, Args&&... args) {
+        for (std::size_t i = 0; i < options.warmup; ++i) {
+            func(args...);
+            clobber_memory();
+        }
+
+        // Double the calls per sample until a sample is long enough to time reliably
+        std::size_t iterations = 1;
+        while (iterations < options.max_iterations && sample_ns(iterations, func, args...) < options.min_sample_ns) {
+            iterations *= 2;
+        }
+
+        // Counters are opened outside the samples and run across all of them
+        std::unique_ptr<PerfCounters> counters;
+        if (options.perf_counters) {
+            counters.reset(new PerfCounters());
+            counters->start();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options.samples);
+        for (std::size_t s = 0; s < options.samples; ++s) {
+            double elapsed = options.use_tsc ? sample_cycles(iterations, func, args...) : sample_ns(iterations, func, args...);
+            samples.push_back(elapsed / iterations);
+        }
+
+        Stats stats = summarize(samples);
+        stats.iterations = iterations;
+        if (counters) {
+            counters->stop();
+            stats.counters = counters->read();
+            stats.counter_error = counters->error();
+            for (double& value : stats.counters.values) {
+                value /= static_cast<double>(options.samples * iterations); // Per call
+            }
+        }
+        stats.unit = options.use_tsc && has_tsc ? "cycles" : "ns";
+        return stats;
+    }
+
+    // Function to benchmark with the default Options
+    template <typename Func, typename... Args>
+    static Stats run(Func func, Args&&... args) {
+        return run(Options(), func, args...);
+    }
+
+    // Function to print one line of statistics
+    static void print(std::ostream& out, const char* name, const Stats& stats) {
+        out << name << ": median " << stats.median << " " << stats.unit
+            << " (min " << stats.min << ", mean " << stats.mean << ", p99 " << stats.p99
+            << ", stddev " << stats.stddev << "; " << stats.samples << " x " << stats.iterations << " calls)\n";
+        if (stats.counter_error != nullptr) {
+            out << "    counters unavailable: " << stats.counter_error << "\n";
+            return;
+        }
+        bool any = false;
+        for (int e = 0; e < PerfCounters::event_count; ++e) {
+            if (stats.counters.valid[e]) {
+                out << (any ? ", " : "    per call: ") << stats.counters.values[e] << " " << PerfCounters::name(static_cast<PerfCounters::Event>(e));
+                any = true;
+            }
+        }
+        if (stats.counters.valid[PerfCounters::cycles] && stats.counters.valid[PerfCounters::instructions] &&
+            stats.counters.values[PerfCounters::cycles] > 0) {
+            out << ", IPC " << stats.counters.values[PerfCounters::instructions] / stats.counters.values[PerfCounters::cycles];
+        }
+        if (any) {
+            out << "\n";
+        }
+    }
+
+private:
+    template <typename Func, typename... Args>
+    static double sample_ns(std::size_t iterations, Func& func, Args&... args) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            func(args...);
+            clobber_memory();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    template <typename Func, typename... Args>
+    static double sample_cycles(std::size_t iterations, Func& func, Args&... args) {
+        std::uint64_t start = read_tsc();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            func(args...);
+            clobber_memory();
+        }
+        return static_cast<double>(read_tsc() - start);
+    }
+
+    static Stats summarize(std::vector<double>& samples) {
+        Stats stats;
+        if (samples.empty()) {
+            return stats;
+        }
+        std::sort(samples.begin(), samples.end());
+        std::size_t count = samples.size();
+
+        double sum = 0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        double mean = sum / count;
+        double variance = 0;
+        for (double sample : samples) {
+            variance += (sample - mean) * (sample - mean);
+        }
+
+        stats.samples = count;
+        stats.min = samples.front();
+        stats.median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+        stats.mean = mean;
+        stats.p99 = samples[std::min(count - 1, static_cast<std::size_t>(std::ceil(0.99 * count)) - 1)];
+        stats.stddev = count > 1 ? std::sqrt(variance / (count - 1)) : 0;
+        return stats;
+    }
 };
 
 #endif // BENCHMARK_HPP
@@ -0,0 +1,520 @@
+// BenchmarkResults.hpp
+#ifndef BENCHMARKRESULTS_HPP
+#define BENCHMARKRESULTS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#ifdef __unix__
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+// Saving benchmark results and comparing two runs.
+//
+// A ResultFile holds one Benchmark::Stats per named benchmark plus metadata
+// describing the run: host, OS, CPU, compiler, C++ standard, build flags and
+// time. write_results stores it as JSON, and read_results loads it back with
+// the small JSON reader below, so nothing outside the standard library is needed.
+//
+// compare_results matches benchmarks by name and computes the change in the
+// median. Samples within one run are not independent of the machine state
+// (clock speed, other load), so their spread says nothing about the drift
+// between runs. The comparison therefore works on whole runs: a file may hold
+// several results with the same name, one per run (read_runs merges files),
+// and a change counts only if the median of the run medians moved by more
+// than the noise threshold and Welch's t-test on the run medians is
+// significant at the 1 % level. With a single run on either side there is no
+// run-to-run spread to test against, so the benchmark is reported as
+// unchanged: on a noisy machine one pair of runs of identical code can differ
+// by tens of percent.
+
+// One named benchmark result
+struct BenchmarkResult {
+    std::string name;
+    Benchmark::Stats stats;
+};
+
+// All results of one run and what they were measured on
+struct ResultFile {
+    std::map<std::string, std::string> metadata;  // host, os, cpu, compiler, flags, time, ...
+    std::vector<BenchmarkResult> results;
+};
+
+// Function to describe the machine and the build of the calling translation unit
+inline std::map<std::string, std::string> collect_metadata() {
+    std::map<std::string, std::string> metadata;
+#if defined(__clang__)
+    metadata["compiler"] = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    metadata["compiler"] = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    metadata["compiler"] = "msvc " + std::to_string(_MSC_VER);
+#else
+    metadata["compiler"] = "unknown";
+#endif
+    metadata["cplusplus"] = std::to_string(__cplusplus);
+    std::string flags;
+#ifdef __OPTIMIZE__
+    flags += "optimized";
+#else
+    flags += "unoptimized";
+#endif
+#ifdef NDEBUG
+    flags += " NDEBUG";
+#endif
+#ifdef __AVX2__
+    flags += " avx2";
+#endif
+#ifdef __AVX512F__
+    flags += " avx512f";
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+    flags += " asan";
+#endif
+    metadata["flags"] = flags;
+    metadata["hardware_threads"] = std::to_string(std::thread::hardware_concurrency());
+
+#ifdef __unix__
+    char host[256] = {};
+    if (gethostname(host, sizeof(host) - 1) == 0) {
+        metadata["host"] = host;
+    }
+    utsname system;
+    if (uname(&system) == 0) {
+        metadata["os"] = std::string(system.sysname) + " " + system.release + " " + system.machine;
+    }
+#endif
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0 && line.find(':') != std::string::npos) {
+            metadata["cpu"] = line.substr(line.find(':') + 2);
+            break;
+        }
+    }
+
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    metadata["time"] = stamp;
+    return metadata;
+}
+
+// Function to write a string as a JSON string literal
+inline void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Function to save results as JSON; returns false if the file cannot be written
+inline bool write_results(const char* path, const ResultFile& file) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << std::setprecision(17) << "{\n  \"metadata\": {";
+    bool first = true;
+    for (const auto& entry : file.metadata) {
+        out << (first ? "\n    " : ",\n    ");
+        write_json_string(out, entry.first);
+        out << ": ";
+        write_json_string(out, entry.second);
+        first = false;
+    }
+    out << "\n  },\n  \"results\": [";
+    for (std::size_t i = 0; i < file.results.size(); ++i) {
+        const Benchmark::Stats& stats = file.results[i].stats;
+        out << (i ? ",\n    " : "\n    ") << "{\"name\": ";
+        write_json_string(out, file.results[i].name);
+        out << ", \"unit\": \"" << stats.unit << "\", \"samples\": " << stats.samples
+            << ", \"iterations\": " << stats.iterations << ", \"min\": " << stats.min
+            << ", \"median\": " << stats.median << ", \"mean\": " << stats.mean
+            << ", \"p99\": " << stats.p99 << ", \"stddev\": " << stats.stddev << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Minimal JSON reader for result files (objects, arrays, strings, numbers, true/false/null)
+class JsonValue {
+public:
+    enum Type { null, boolean, number, string, array, object };
+
+    Type type = null;
+    double number_value = 0;
+    std::string string_value;                     // Also holds "true"/"false" for booleans
+    std::vector<JsonValue> items;                 // Array elements
+    std::vector<std::pair<std::string, JsonValue>> members; // Object members in file order
+
+    // Function to get an object member (a null value if missing)
+    const JsonValue& operator[](const std::string& key) const {
+        static const JsonValue missing;
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return member.second;
+            }
+        }
+        return missing;
+    }
+
+    // Function to parse text; returns false on malformed input
+    static bool parse(const std::string& text, JsonValue& value) {
+        std::size_t pos = 0;
+        return parse_value(text, pos, value) && (skip_space(text, pos), pos == text.size());
+    }
+
+private:
+    static void skip_space(const std::string& text, std::size_t& pos) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t')) {
+            pos++;
+        }
+    }
+
+    static bool parse_string(const std::string& text, std::size_t& pos, std::string& out) {
+        if (pos >= text.size() || text[pos] != '"') {
+            return false;
+        }
+        for (pos++; pos < text.size(); pos++) {
+            char c = text[pos];
+            if (c == '"') {
+                pos++;
+                return true;
+            }
+            if (c == '\\') {
+                if (++pos >= text.size()) {
+                    return false;
+                }
+                char escaped = text[pos];
+                if (escaped == 'u') {
+                    if (pos + 4 >= text.size()) {
+                        return false;
+                    }
+                    out += static_cast<char>(std::strtol(text.substr(pos + 1, 4).c_str(), nullptr, 16)); // Only the escapes write_json_string emits
+                    pos += 4;
+                } else {
+                    out += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped == 'r' ? '\r' : escaped;
+                }
+            } else {
+                out += c;
+            }
+        }
+        return false;
+    }
+
+    static bool parse_value(const std::string& text, std::size_t& pos, JsonValue& value) {
+        skip_space(text, pos);
+        if (pos >= text.size()) {
+            return false;
+        }
+        char c = text[pos];
+        if (c == '{') {
+            value.type = object;
+            pos++;
+            skip_space(text, pos);
+            if (pos < text.size() && text[pos] == '}') {
+                pos++;
+                return true;
+            }
+            for (;;) {
+                std::string key;
+                JsonValue member;
+                skip_space(text, pos);
+                if (!parse_string(text, pos, key)) {
+                    return false;
+                }
+                skip_space(text, pos);
+                if (pos >= text.size() || text[pos++] != ':' || !parse_value(text, pos, member)) {
+                    return false;
+                }
+                value.members.emplace_back(key, member);
+                skip_space(text, pos);
+                if (pos < text.size() && text[pos] == ',') {
+                    pos++;
+                } else {
+                    return pos < text.size() && text[pos++] == '}';
+                }
+            }
+        }
+        if (c == '[') {
+            value.type = array;
+            pos++;
+            skip_space(text, pos);
+            if (pos < text.size() && text[pos] == ']') {
+                pos++;
+                return true;
+            }
+            for (;;) {
+                JsonValue item;
+                if (!parse_value(text, pos, item)) {
+                    return false;
+                }
+                value.items.push_back(item);
+                skip_space(text, pos);
+                if (pos < text.size() && text[pos] == ',') {
+                    pos++;
+                } else {
+                    return pos < text.size() && text[pos++] == ']';
+                }
+            }
+        }
+        if (c == '"') {
+            value.type = string;
+            return parse_string(text, pos, value.string_value);
+        }
+        for (const char* word : {"true", "false", "null"}) {
+            if (text.compare(pos, std::strlen(word), word) == 0) {
+                value.type = word[0] == 'n' ? null : boolean;
+                value.string_value = word;
+                pos += std::strlen(word);
+                return true;
+            }
+        }
+        const char* start = text.c_str() + pos;
+        char* end = nullptr;
+        value.number_value = std::strtod(start, &end);
+        if (end == start) {
+            return false;
+        }
+        value.type = number;
+        pos += static_cast<std::size_t>(end - start);
+        return true;
+    }
+};
+
+// Function to load results written by write_results; returns false if the file is missing or malformed
+inline bool read_results(const char* path, ResultFile& file) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    JsonValue root;
+    if (!JsonValue::parse(buffer.str(), root) || root["results"].type != JsonValue::array) {
+        return false;
+    }
+    file.metadata.clear();
+    for (const auto& member : root["metadata"].members) {
+        file.metadata[member.first] = member.second.string_value;
+    }
+    file.results.clear();
+    for (const JsonValue& item : root["results"].items) {
+        BenchmarkResult result;
+        result.name = item["name"].string_value;
+        result.stats.unit = item["unit"].string_value == "cycles" ? "cycles" : "ns";
+        result.stats.samples = static_cast<std::size_t>(item["samples"].number_value);
+        result.stats.iterations = static_cast<std::size_t>(item["iterations"].number_value);
+        result.stats.min = item["min"].number_value;
+        result.stats.median = item["median"].number_value;
+        result.stats.mean = item["mean"].number_value;
+        result.stats.p99 = item["p99"].number_value;
+        result.stats.stddev = item["stddev"].number_value;
+        file.results.push_back(result);
+    }
+    return true;
+}
+
+// Function to load several result files (paths separated by commas) as repeated runs of one build.
+// The results are concatenated, so each benchmark appears once per run; metadata comes from the first file.
+inline bool read_runs(const std::string& paths, ResultFile& file) {
+    file = ResultFile();
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t comma = paths.find(',', start);
+        ResultFile run;
+        if (!read_results(paths.substr(start, comma - start).c_str(), run)) {
+            return false;
+        }
+        if (file.metadata.empty()) {
+            file.metadata = run.metadata;
+        }
+        file.results.insert(file.results.end(), run.results.begin(), run.results.end());
+        if (comma == std::string::npos) {
+            return true;
+        }
+        start = comma + 1;
+    }
+}
+
+// Outcome of comparing one benchmark between two builds
+struct Comparison {
+    enum Verdict { unchanged, improved, regressed, missing };
+
+    std::string name;
+    double old_median = 0;      // Median of the old run medians
+    double new_median = 0;      // Median of the new run medians
+    double change_percent = 0;  // (new - old) / old, in percent of the old median
+    double t = 0;               // Welch's t statistic of the run medians, 0 with a single run on either side
+    std::size_t old_runs = 0;   // Runs of the benchmark in each file
+    std::size_t new_runs = 0;
+    Verdict verdict = missing;  // missing: the benchmark is in only one of the files
+};
+
+// Function to get the two-sided 1 % critical value of Student's t with df degrees of freedom.
+// Exact table values; a fractional df is rounded down to the next entry, which is conservative.
+inline double t_critical_99(double df) {
+    static const double table[] = {63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250, 3.169,
+                                   3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878, 2.861, 2.845,
+                                   2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771, 2.763, 2.756, 2.750};
+    if (df < 1) {
+        return table[0]; // Fewer degrees of freedom than any test can use
+    }
+    if (df < 31) {
+        return table[static_cast<std::size_t>(df) - 1];
+    }
+    return df < 40 ? 2.750 : df < 60 ? 2.704 : df < 120 ? 2.660 : 2.617;
+}
+
+// Function to get the median of values (sorted in place)
+inline double median_of(std::vector<double>& values) {
+    std::sort(values.begin(), values.end());
+    std::size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+// Function to get the mean and the sample variance of values
+inline void mean_and_variance(const std::vector<double>& values, double& mean, double& variance) {
+    mean = 0;
+    for (double value : values) {
+        mean += value;
+    }
+    mean /= static_cast<double>(values.size());
+    variance = 0;
+    for (double value : values) {
+        variance += (value - mean) * (value - mean);
+    }
+    variance /= static_cast<double>(values.size() - 1);
+}
+
+// Function to compare every benchmark of old_run with new_run, each holding one or more runs.
+// threshold_percent is the smallest change in the median worth reporting; smaller changes are noise.
+inline std::vector<Comparison> compare_results(const ResultFile& old_run, const ResultFile& new_run, double threshold_percent) {
+    std::vector<Comparison> comparisons;
+    auto listed = [&](const std::string& name) {
+        for (const Comparison& comparison : comparisons) {
+            if (comparison.name == name) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (const BenchmarkResult& first : old_run.results) {
+        if (listed(first.name)) {
+            continue; // A later run of a benchmark already compared
+        }
+        std::vector<double> old_medians, new_medians;
+        for (const BenchmarkResult& before : old_run.results) {
+            if (before.name == first.name) {
+                old_medians.push_back(before.stats.median);
+            }
+        }
+        for (const BenchmarkResult& after : new_run.results) {
+            if (after.name == first.name && std::string(after.stats.unit) == first.stats.unit) {
+                new_medians.push_back(after.stats.median);
+            }
+        }
+
+        Comparison comparison;
+        comparison.name = first.name;
+        comparison.old_runs = old_medians.size();
+        comparison.new_runs = new_medians.size();
+        if (!new_medians.empty()) {
+            double n1 = static_cast<double>(old_medians.size()), n2 = static_cast<double>(new_medians.size());
+            bool significant = false; // A single run on either side cannot be tested
+            if (n1 > 1 && n2 > 1) {
+                double mean1, mean2, v1, v2;
+                mean_and_variance(old_medians, mean1, v1);
+                mean_and_variance(new_medians, mean2, v2);
+                v1 /= n1;
+                v2 /= n2;
+                if (v1 + v2 > 0) {
+                    comparison.t = (mean2 - mean1) / std::sqrt(v1 + v2);
+                    double df = (v1 + v2) * (v1 + v2) / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1)); // Welch-Satterthwaite
+                    significant = std::fabs(comparison.t) > t_critical_99(df);
+                } else {
+                    significant = mean2 != mean1; // Every run gave the same median
+                }
+            }
+
+            comparison.old_median = median_of(old_medians);
+            comparison.new_median = median_of(new_medians);
+            comparison.change_percent = comparison.old_median > 0
+                ? (comparison.new_median - comparison.old_median) / comparison.old_median * 100 : 0;
+            comparison.verdict = !significant || std::fabs(comparison.change_percent) <= threshold_percent
+                ? Comparison::unchanged
+                : comparison.change_percent > 0 ? Comparison::regressed : Comparison::improved;
+        } else {
+            comparison.old_median = median_of(old_medians);
+        }
+        comparisons.push_back(comparison);
+    }
+    for (const BenchmarkResult& after : new_run.results) {
+        if (!listed(after.name)) {
+            Comparison comparison;
+            comparison.name = after.name;
+            comparison.new_median = after.stats.median;
+            comparison.new_runs = 1;
+            comparisons.push_back(comparison);
+        }
+    }
+    return comparisons;
+}
+
+// Function to print a comparison table and metadata differences; returns the number of regressions
+inline std::size_t print_comparison(std::ostream& out, const ResultFile& old_run, const ResultFile& new_run, double threshold_percent) {
+    for (const char* key : {"host", "cpu", "compiler", "flags"}) {
+        auto before = old_run.metadata.find(key), after = new_run.metadata.find(key);
+        std::string old_value = before != old_run.metadata.end() ? before->second : "?";
+        std::string new_value = after != new_run.metadata.end() ? after->second : "?";
+        if (old_value != new_value) {
+            out << "warning: " << key << " differs: " << old_value << " -> " << new_value << "\n";
+        }
+    }
+
+    static const char* const verdicts[] = {"unchanged", "improved", "REGRESSED", "missing"};
+    std::size_t regressions = 0;
+    bool single_runs = false;
+    out << std::left << std::setw(44) << "Benchmark" << std::right << std::setw(14) << "old median"
+        << std::setw(14) << "new median" << std::setw(10) << "change" << std::setw(9) << "t" << std::setw(7) << "runs"
+        << "  verdict\n";
+    for (const Comparison& comparison : compare_results(old_run, new_run, threshold_percent)) {
+        out << std::left << std::setw(44) << comparison.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << comparison.old_median << std::setw(14) << comparison.new_median
+            << std::setw(9) << comparison.change_percent << "%" << std::setw(9) << comparison.t
+            << std::setw(3) << comparison.old_runs << "/" << std::left << std::setw(3) << comparison.new_runs
+            << std::right << "  " << verdicts[comparison.verdict] << "\n";
+        out.unsetf(std::ios::fixed);
+        regressions += comparison.verdict == Comparison::regressed;
+        single_runs |= comparison.verdict != Comparison::missing && (comparison.old_runs < 2 || comparison.new_runs < 2);
+    }
+    out << regressions << " regression(s) beyond " << threshold_percent << " % at p < 0.01\n";
+    if (single_runs) {
+        out << "note: benchmarks with a single run on either side cannot be tested and are reported as unchanged; "
+               "compare several runs per build (a.json,b.json,...)\n";
+    }
+    return regressions;
+}
+
+#endif // BENCHMARKRESULTS_HPP
@@ -0,0 +1,128 @@
+#ifndef BUMPALLOCATORATOMIC_HPP
+#define BUMPALLOCATORATOMIC_HPP
+
+#include <atomic>   // For the lock-free bump state
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint64_t and uintptr_t
+#include <limits>   // For the heap size limit
+
+// Class defining a lock-free upward bump allocator.
+//
+// The bump offset and the number of active allocations are packed into a
+// single 64-bit atomic word (count in the high 32 bits, offset in the low 32
+// bits). alloc() and dealloc() advance that word with a CAS loop, so the
+// "reset when the last allocation is freed" rule of the mutex-based allocators
+// still holds: a reset can never hand out memory that another thread has just
+// claimed, because the claim and the count live in the same word.
+class BumpAllocatorAtomic {
+public:
+    // Largest heap the packed 32-bit offset can address
+    static constexpr std::size_t max_heap_size = std::numeric_limits<std::uint32_t>::max();
+
+    // Constructor: Initializes the allocator with a fixed heap size
+    BumpAllocatorAtomic(std::size_t heap_size) {
+        if (heap_size > max_heap_size) {
+            heap_size = max_heap_size;   // Clamp to what the packed offset can represent
+        }
+        heap = new char[heap_size];      // Allocate memory for the heap
+        total_size = heap_size;          // Remember the size of the heap
+        state.store(0, std::memory_order_relaxed);             // Offset 0, no active allocations
+        total_allocations.store(0, std::memory_order_relaxed); // Initialize total allocations counter
+    }
+
+    // Destructor: Cleans up allocated memory
+    ~BumpAllocatorAtomic() {
+        delete[] heap; // Free the allocated heap memory
+    }
+
+    BumpAllocatorAtomic(const BumpAllocatorAtomic&) = delete;
+    BumpAllocatorAtomic& operator=(const BumpAllocatorAtomic&) = delete;
+
+    // Template function for memory allocation (lock-free)
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        std::size_t alignment = alignof(T);                 // Get alignment for the data type
+        if (num_objects > total_size / sizeof(T)) {
+            return nullptr;                                 // Can never fit, avoid overflow below
+        }
+        std::size_t required_size = sizeof(T) * num_objects; // Calculate required memory size
+
+        std::uint64_t current = state.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t offset = unpack_offset(current);
+            std::size_t count = unpack_count(current);
+
+            // Align the offset by moving it forward
+            std::size_t aligned_offset = align_offset(offset, alignment);
+
+            // Check if the aligned offset plus required size is within bounds
+            if (aligned_offset > total_size || required_size > total_size - aligned_offset) {
+                return nullptr; // Return null pointer if allocation fails
+            }
+
+            std::uint64_t desired = pack(count + 1, aligned_offset + required_size);
+            if (state.compare_exchange_weak(current, desired,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                total_allocations.fetch_add(1, std::memory_order_relaxed);
+                return reinterpret_cast<T*>(heap + aligned_offset); // Return aligned pointer cast to T*
+            }
+            // Another thread moved the bump offset, retry with the fresh state in current
+        }
+    }
+
+    // Function to deallocate memory (lock-free)
+    void dealloc() {
+        std::uint64_t current = state.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t count = unpack_count(current);
+            if (count > 0) {
+                count--; // Decrease allocation count
+            }
+
+            // Reset the allocator if all allocations are deallocated
+            std::size_t offset = (count == 0) ? 0 : unpack_offset(current);
+
+            if (state.compare_exchange_weak(current, pack(count, offset),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    // Function to get the remaining memory available
+    std::size_t remaining_memory() const {
+        return total_size - unpack_offset(state.load(std::memory_order_acquire));
+    }
+
+private:
+    char* heap;                                 // Pointer to the start of the heap
+    std::size_t total_size;                     // Total size of the heap
+    alignas(64) std::atomic<std::uint64_t> state;       // Packed (allocation count, bump offset)
+    alignas(64) std::atomic<std::size_t> total_allocations; // Total number of allocations ever made
+
+    static std::uint64_t pack(std::size_t count, std::size_t offset) {
+        return (static_cast<std::uint64_t>(count) << 32) | static_cast<std::uint64_t>(offset);
+    }
+
+    static std::size_t unpack_count(std::uint64_t packed) {
+        return static_cast<std::size_t>(packed >> 32);
+    }
+
+    static std::size_t unpack_offset(std::uint64_t packed) {
+        return static_cast<std::size_t>(packed & 0xFFFFFFFFu);
+    }
+
+    // Function to align an offset so that heap + offset has the required alignment
+    std::size_t align_offset(std::size_t offset, std::size_t alignment) const {
+        std::size_t mask = alignment - 1;                   // Create alignment mask
+        std::size_t misalignment = (reinterpret_cast<std::uintptr_t>(heap) + offset) & mask; // Calculate misalignment
+        if (misalignment != 0) {
+            offset += (alignment - misalignment); // Adjust the offset forward to align
+        }
+        return offset; // Return aligned offset
+    }
+};
+
+#endif // BUMPALLOCATORATOMIC_HPP
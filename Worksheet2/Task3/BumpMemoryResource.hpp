@@ -0,0 +1,101 @@
+#ifndef BUMPMEMORYRESOURCE_HPP
+#define BUMPMEMORYRESOURCE_HPP
+
+#include <cstddef>          // For size_t
+#include <limits>           // For max_size
+#include <memory_resource>  // For std::pmr::memory_resource
+#include <new>              // For std::bad_alloc and std::bad_array_new_length
+
+// std::pmr::memory_resource backed by a bump allocator.
+//
+// Lets pmr containers (std::pmr::vector, std::pmr::string, ...) run entirely
+// out of the arena. Allocator must provide alloc_bytes(size, alignment) and
+// dealloc(), as BumpAllocator, BumpAllocatorUpwards and BumpAllocatorDownwards
+// do. Every deallocate() maps to one dealloc(), so the arena resets once every
+// container using it has released its memory.
+template <typename Allocator>
+class BumpMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit BumpMemoryResource(Allocator& allocator) : allocator(allocator) {}
+
+    Allocator& underlying() const {
+        return allocator;
+    }
+
+private:
+    Allocator& allocator; // Arena the resource allocates from
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* ptr = allocator.alloc_bytes(bytes, alignment);
+        if (ptr == nullptr) {
+            throw std::bad_alloc(); // memory_resource must not return nullptr
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {
+        allocator.dealloc(); // Bump allocators only count frees
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// C++ Allocator-concept adapter over a bump allocator, for containers that
+// take an allocator template argument rather than a memory_resource:
+//
+//     std::vector<int, BumpStlAllocator<int, BumpAllocatorUpwards>> v(BumpStlAllocator<int, BumpAllocatorUpwards>(arena));
+template <typename T, typename Allocator>
+class BumpStlAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = BumpStlAllocator<U, Allocator>;
+    };
+
+    explicit BumpStlAllocator(Allocator& allocator) : allocator(&allocator) {}
+
+    template <typename U>
+    BumpStlAllocator(const BumpStlAllocator<U, Allocator>& other) : allocator(other.allocator) {}
+
+    T* allocate(std::size_t n) {
+        if (n > max_size()) {
+            throw std::bad_array_new_length(); // sizeof(T) * n would wrap, as in std::allocator
+        }
+        void* ptr = allocator->alloc_bytes(sizeof(T) * n, alignof(T));
+        if (ptr == nullptr) {
+            throw std::bad_alloc(); // Allocators must not return nullptr
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T*, std::size_t) {
+        allocator->dealloc(); // Bump allocators only count frees
+    }
+
+    // Function to get the largest n whose size in bytes fits in size_t
+    std::size_t max_size() const {
+        return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    template <typename U>
+    bool operator==(const BumpStlAllocator<U, Allocator>& other) const {
+        return allocator == other.allocator;
+    }
+
+    template <typename U>
+    bool operator!=(const BumpStlAllocator<U, Allocator>& other) const {
+        return allocator != other.allocator;
+    }
+
+private:
+    template <typename U, typename A>
+    friend class BumpStlAllocator;
+
+    Allocator* allocator; // Arena the adapter allocates from
+};
+
+#endif // BUMPMEMORYRESOURCE_HPP
@@ -0,0 +1,225 @@
+#ifndef CHAINEDBUMPALLOCATOR_HPP
+#define CHAINEDBUMPALLOCATOR_HPP
+
+#include <algorithm> // For std::max and std::min
+#include <cstddef>   // For size_t and max_align_t
+#include <cstdint>   // For uintptr_t
+#include <mutex>     // For thread-safety using std::mutex
+#include <new>       // For std::nothrow and placement new
+
+// Growth policy for ChainedBumpAllocator: every new block is growth_factor
+// times the previous one, capped at max_block_size. A single request larger
+// than the cap still gets a block sized to fit it, and so does the block kept
+// by a reset (see ChainedBumpAllocator).
+struct GrowthPolicy {
+    std::size_t initial_block_size = 4096;       // Size of the first block
+    double growth_factor = 2.0;                  // Multiplier applied to each new block
+    std::size_t max_block_size = 1024 * 1024;    // Upper bound for a regular block
+};
+
+// Class defining an upward bump allocator that grows by chaining blocks.
+//
+// Instead of returning nullptr when the heap is full, alloc links on a new
+// block sized by the GrowthPolicy. When every allocation has been freed the
+// allocator keeps a single block big enough for the round that just ended:
+// its largest block, or one new block of the round's size (even above
+// max_block_size) when the round spilled over several blocks. A steady-state
+// workload therefore stops calling the system allocator after the first round.
+class ChainedBumpAllocator {
+public:
+    // Constructor: Allocates the first block according to the growth policy
+    ChainedBumpAllocator(GrowthPolicy growth_policy = GrowthPolicy()) : policy(growth_policy) {
+        current = nullptr;
+        next = nullptr;
+        block_end = nullptr;
+        allocation_count = 0;            // Initialize allocation counter
+        total_allocations = 0;           // Initialize total allocations counter
+        blocks = 0;
+        add_block(policy.initial_block_size);
+    }
+
+    // Destructor: Frees every block in the chain
+    ~ChainedBumpAllocator() {
+        while (current != nullptr) {
+            Block* prev = current->prev;
+            free_block(current);
+            current = prev;
+        }
+    }
+
+    ChainedBumpAllocator(const ChainedBumpAllocator&) = delete;
+    ChainedBumpAllocator& operator=(const ChainedBumpAllocator&) = delete;
+
+    // Template function for memory allocation
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        std::size_t required_size = sizeof(T) * num_objects; // Calculate required memory size
+        std::size_t alignment = alignof(T);                 // Get alignment for the data type
+
+        char* aligned_ptr = try_bump(required_size, alignment);
+        if (aligned_ptr == nullptr) {
+            // Current block is exhausted: chain on a new one big enough for this request
+            std::size_t grown = static_cast<std::size_t>(current ? current->size * policy.growth_factor
+                                                                 : policy.initial_block_size);
+            std::size_t block_size = std::min(std::max(grown, policy.initial_block_size), policy.max_block_size);
+            block_size = std::max(block_size, required_size + alignment);
+            if (!add_block(block_size)) {
+                return nullptr; // System allocator is out of memory
+            }
+            aligned_ptr = try_bump(required_size, alignment);
+        }
+
+        allocation_count++;       // Increment the current allocation count
+        total_allocations++;      // Increment the total allocations count
+        return reinterpret_cast<T*>(aligned_ptr); // Return aligned pointer cast to T*
+    }
+
+    // Function to deallocate memory
+    void dealloc() {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        if (allocation_count > 0) {
+            allocation_count--; // Decrease allocation count
+        }
+
+        // Reset the allocator if all allocations are deallocated
+        if (allocation_count == 0) {
+            reset_to_one_block();
+        }
+    }
+
+    // Function to get the remaining memory available in the current block
+    std::size_t remaining_memory() const {
+        return block_end - next;
+    }
+
+    // Function to get the number of blocks in the chain
+    std::size_t block_count() const {
+        return blocks;
+    }
+
+    // Function to get the combined size of every block in the chain
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (Block* block = current; block != nullptr; block = block->prev) {
+            total += block->size;
+        }
+        return total;
+    }
+
+private:
+    // Header stored at the start of every block; the usable memory follows it
+    struct alignas(std::max_align_t) Block {
+        Block* prev;        // Previously filled block
+        std::size_t size;   // Usable bytes after the header
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    GrowthPolicy policy;            // How new blocks are sized
+    Block* current;                 // Block currently being bumped
+    char* next;                     // Bump pointer for the next allocation
+    char* block_end;                // End of the current block
+    std::size_t blocks;             // Number of blocks in the chain
+    std::size_t allocation_count;   // Number of active allocations
+    std::size_t total_allocations;  // Total number of allocations ever made
+    std::mutex alloc_mutex;         // Mutex for thread-safety
+
+    // Function to bump inside the current block, nullptr if it does not fit
+    char* try_bump(std::size_t required_size, std::size_t alignment) {
+        if (current == nullptr) {
+            return nullptr;
+        }
+        char* aligned_ptr = align_pointer(next, alignment);
+        if (aligned_ptr > block_end || required_size > static_cast<std::size_t>(block_end - aligned_ptr)) {
+            return nullptr;
+        }
+        next = aligned_ptr + required_size; // Move the bump pointer forward
+        return aligned_ptr;
+    }
+
+    // Function to link a new block of the given usable size onto the chain
+    bool add_block(std::size_t size) {
+        Block* block = make_block(size, current);
+        if (block == nullptr) {
+            return false;
+        }
+        current = block;
+        next = block->data();
+        block_end = next + size;
+        blocks++;
+        return true;
+    }
+
+    // Function to get a block of the given usable size from the system allocator, nullptr if it fails
+    static Block* make_block(std::size_t size, Block* prev) {
+        char* raw = new (std::nothrow) char[sizeof(Block) + size];
+        if (raw == nullptr) {
+            return nullptr;
+        }
+        return new (raw) Block{prev, size};
+    }
+
+    static void free_block(Block* block) {
+        delete[] reinterpret_cast<char*>(block);
+    }
+
+    // Function to keep one block that fits the whole round and rewind to its start.
+    // Earlier blocks count whole, rounded up to max_align_t, so every allocation
+    // lands no later in the kept block than it did in the chain and the round fits again.
+    void reset_to_one_block() {
+        if (current == nullptr) {
+            return;
+        }
+        std::size_t used = round_up(static_cast<std::size_t>(next - current->data()));
+        Block* largest = current;
+        for (Block* block = current->prev; block != nullptr; block = block->prev) {
+            used += round_up(block->size);
+            if (block->size > largest->size) {
+                largest = block;
+            }
+        }
+
+        Block* kept = largest;
+        if (used > largest->size) {
+            Block* merged = make_block(used, nullptr);
+            if (merged != nullptr) {
+                kept = merged; // Otherwise keep the largest block and grow again next round
+            }
+        }
+
+        Block* block = current;
+        while (block != nullptr) {
+            Block* prev = block->prev;
+            if (block != kept) {
+                free_block(block);
+            }
+            block = prev;
+        }
+
+        kept->prev = nullptr;
+        current = kept;
+        next = kept->data();
+        block_end = next + kept->size;
+        blocks = 1;
+    }
+
+    // Function to round a size up to a multiple of the block alignment
+    static std::size_t round_up(std::size_t size) {
+        std::size_t alignment = alignof(std::max_align_t);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // Function to align a pointer to the required alignment
+    char* align_pointer(char* ptr, std::size_t alignment) const {
+        std::size_t mask = alignment - 1;                   // Create alignment mask
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & mask; // Calculate misalignment
+        if (misalignment != 0) {
+            ptr += (alignment - misalignment); // Adjust the pointer forward to align
+        }
+        return ptr; // Return aligned pointer
+    }
+};
+
+#endif // CHAINEDBUMPALLOCATOR_HPP
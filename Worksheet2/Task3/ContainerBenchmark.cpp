@@ -0,0 +1,90 @@
+#include "BumpAllocatorUpwards.hpp"
+#include "BumpAllocatorDownwards.hpp"
+#include "BumpMemoryResource.hpp"
+#include "Benchmark.hpp"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// Number of elements each container workload inserts.
+constexpr int element_count = 10000;
+
+//Build an ordered map node by node (one allocation per insert).
+template <typename Map>
+void map_build(Map& map) {
+    for (int i = 0; i < element_count; ++i) {
+        map.emplace(i, i * 2);
+    }
+}
+
+//Fill a vector with strings too long for the small-string buffer (two allocations per element plus regrowth).
+template <typename Vector>
+void vector_of_strings(Vector& strings) {
+    for (int i = 0; i < element_count; ++i) {
+        strings.emplace_back("benchmark string that is longer than SSO #");
+    }
+}
+
+//Print one result line.
+void report(const char* workload, const char* backend, double time_ms) {
+    std::cout << workload << " - " << backend << ": " << time_ms << " ms\n";
+}
+
+//Run both workloads through a pmr resource backed by the given arena.
+template <typename Allocator>
+void run_pmr(const char* backend, Allocator& arena) {
+    BumpMemoryResource<Allocator> resource(arena);
+
+    report("Map Build", backend, Benchmark::measure_time_ms([&resource] {
+        std::pmr::map<int, int> map(&resource);
+        map_build(map);
+    }));
+
+    report("Vector of Strings", backend, Benchmark::measure_time_ms([&resource] {
+        std::pmr::vector<std::pmr::string> strings(&resource);
+        vector_of_strings(strings);
+    }));
+}
+
+int main() {
+    //Arenas large enough that no workload runs out of memory.
+    BumpAllocatorUpwards arena_up(16 * 1024 * 1024);
+    BumpAllocatorDownwards arena_down(16 * 1024 * 1024);
+
+    //Baseline: the default global heap.
+    report("Map Build", "Default heap", Benchmark::measure_time_ms([] {
+        std::map<int, int> map;
+        map_build(map);
+    }));
+    report("Vector of Strings", "Default heap", Benchmark::measure_time_ms([] {
+        std::vector<std::string> strings;
+        vector_of_strings(strings);
+    }));
+
+    //pmr containers over the upward and downward arenas.
+    run_pmr("pmr BumpAllocatorUpwards", arena_up);
+    run_pmr("pmr BumpAllocatorDownwards", arena_down);
+
+    //Allocator-template containers over the upward arena.
+    using MapAllocator = BumpStlAllocator<std::pair<const int, int>, BumpAllocatorUpwards>;
+    using CharAllocator = BumpStlAllocator<char, BumpAllocatorUpwards>;
+    using ArenaString = std::basic_string<char, std::char_traits<char>, CharAllocator>;
+    using StringAllocator = BumpStlAllocator<ArenaString, BumpAllocatorUpwards>;
+
+    report("Map Build", "STL adapter BumpAllocatorUpwards", Benchmark::measure_time_ms([&arena_up] {
+        std::map<int, int, std::less<int>, MapAllocator> map{MapAllocator(arena_up)};
+        map_build(map);
+    }));
+    report("Vector of Strings", "STL adapter BumpAllocatorUpwards", Benchmark::measure_time_ms([&arena_up] {
+        CharAllocator char_allocator(arena_up);
+        std::vector<ArenaString, StringAllocator> strings{StringAllocator(arena_up)};
+        for (int i = 0; i < element_count; ++i) {
+            strings.emplace_back("benchmark string that is longer than SSO #", char_allocator);
+        }
+    }));
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#ifndef DESTRUCTORREGISTRY_HPP
+#define DESTRUCTORREGISTRY_HPP
+
+#include <cstddef>      // For size_t
+#include <new>          // For placement new
+#include <type_traits>  // For std::is_trivially_destructible
+
+// Intrusive list of destructors for objects constructed inside a bump arena.
+//
+// create<T>/create_array<T> place one Entry in front of each block of objects
+// whose type has a non-trivial destructor, so the registry itself needs no
+// memory outside the arena. Trivially destructible types get no entry at all
+// (header_size<T>() is 0), selected at compile time. Entries form a LIFO list,
+// so objects are destroyed in reverse order of construction.
+class DestructorRegistry {
+public:
+    // Destructor record stored in the arena right before the objects it destroys
+    struct Entry {
+        void (*destroy)(void*, std::size_t); // Type-erased destructor loop
+        void* objects;                       // First object to destroy
+        std::size_t count;                   // Number of objects
+        Entry* prev;                         // Previously registered entry
+    };
+
+    template <typename T>
+    static constexpr bool needs_entry = !std::is_trivially_destructible<T>::value;
+
+    // Bytes reserved in front of the objects for their Entry (0 when none is needed)
+    template <typename T>
+    static constexpr std::size_t header_size() {
+        return needs_entry<T> ? (sizeof(Entry) + alignof(T) - 1) / alignof(T) * alignof(T) : 0;
+    }
+
+    // Alignment of the whole block (Entry followed by the objects)
+    template <typename T>
+    static constexpr std::size_t block_alignment() {
+        return (needs_entry<T> && alignof(Entry) > alignof(T)) ? alignof(Entry) : alignof(T);
+    }
+
+    // Function to destroy count objects of type T in reverse order
+    template <typename T>
+    static void destroy(void* objects, std::size_t count) {
+        T* typed = static_cast<T*>(objects);
+        for (std::size_t i = count; i > 0; --i) {
+            typed[i - 1].~T();
+        }
+    }
+
+    DestructorRegistry() : head(nullptr) {}
+
+    // Function to record objects whose Entry lives at the start of block
+    template <typename T>
+    void record(void* block, T* objects, std::size_t count) {
+        head = new (block) Entry{&destroy<T>, objects, count, head};
+    }
+
+    // Function to run (and forget) every entry registered after stop
+    void run_until(Entry* stop) {
+        while (head != nullptr && head != stop) {
+            Entry* entry = head;
+            head = entry->prev;
+            entry->destroy(entry->objects, entry->count);
+        }
+    }
+
+    // Function to run every registered destructor
+    void run_all() {
+        run_until(nullptr);
+    }
+
+    Entry* top() const {
+        return head;
+    }
+
+private:
+    Entry* head; // Most recently registered entry
+};
+
+#endif // DESTRUCTORREGISTRY_HPP
@@ -0,0 +1,143 @@
+#ifndef DOUBLEENDEDBUMPALLOCATOR_HPP
+#define DOUBLEENDEDBUMPALLOCATOR_HPP
+
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uintptr_t
+#include <mutex>    // For thread-safety using std::mutex
+
+// Class defining a double-ended bump allocator.
+//
+// One buffer is shared by two bump pointers: the low side grows upwards from
+// the start of the heap (long-lived data) and the high side grows downwards
+// from the end (short-lived scratch). Each side keeps its own allocation count
+// and resets independently; an allocation fails only when the two sides would
+// cross.
+class DoubleEndedBumpAllocator {
+public:
+    // Constructor: Initializes the allocator with a fixed heap size
+    DoubleEndedBumpAllocator(std::size_t heap_size) {
+        heap = new char[heap_size];      // Allocate memory for the heap
+        heap_end = heap + heap_size;     // Mark the end of the heap
+        low_next = heap;                 // Low side starts at the bottom
+        high_next = heap_end;            // High side starts at the top
+        low_count = 0;                   // Initialize low side allocation counter
+        high_count = 0;                  // Initialize high side allocation counter
+        total_allocations = 0;           // Initialize total allocations counter
+    }
+
+    // Destructor: Cleans up allocated memory
+    ~DoubleEndedBumpAllocator() {
+        delete[] heap; // Free the allocated heap memory
+    }
+
+    DoubleEndedBumpAllocator(const DoubleEndedBumpAllocator&) = delete;
+    DoubleEndedBumpAllocator& operator=(const DoubleEndedBumpAllocator&) = delete;
+
+    // Template function for memory allocation from the bottom (upwards)
+    template <typename T>
+    T* alloc_low(std::size_t num_objects) {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        std::size_t required_size = sizeof(T) * num_objects; // Calculate required memory size
+        char* aligned_ptr = align_up(low_next, alignof(T));  // Align the pointer by moving it forward
+
+        // Check the allocation does not run into the high side
+        if (aligned_ptr <= high_next && required_size <= static_cast<std::size_t>(high_next - aligned_ptr)) {
+            low_next = aligned_ptr + required_size; // Move the low pointer forward
+            low_count++;
+            total_allocations++;
+            return reinterpret_cast<T*>(aligned_ptr);
+        }
+        return nullptr; // The two sides would collide
+    }
+
+    // Template function for memory allocation from the top (downwards)
+    template <typename T>
+    T* alloc_high(std::size_t num_objects) {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        std::size_t required_size = sizeof(T) * num_objects; // Calculate required memory size
+
+        // Check the allocation does not run into the low side
+        if (required_size > static_cast<std::size_t>(high_next - low_next)) {
+            return nullptr; // The two sides would collide
+        }
+        char* aligned_ptr = align_down(high_next - required_size, alignof(T)); // Align the pointer by moving it backward
+        if (aligned_ptr < low_next) {
+            return nullptr; // Alignment padding pushed it into the low side
+        }
+
+        high_next = aligned_ptr; // Move the high pointer backward
+        high_count++;
+        total_allocations++;
+        return reinterpret_cast<T*>(aligned_ptr);
+    }
+
+    // Function to deallocate memory from the low side (reset it when all are freed)
+    void dealloc_low() {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        if (low_count > 0) {
+            low_count--;
+        }
+        if (low_count == 0) {
+            low_next = heap; // Reset only the low side
+        }
+    }
+
+    // Function to deallocate memory from the high side (reset it when all are freed)
+    void dealloc_high() {
+        std::lock_guard<std::mutex> guard(alloc_mutex); // Ensure thread-safety
+
+        if (high_count > 0) {
+            high_count--;
+        }
+        if (high_count == 0) {
+            high_next = heap_end; // Reset only the high side
+        }
+    }
+
+    // Function to get the free memory left between the two sides
+    std::size_t remaining_memory() const {
+        return high_next - low_next;
+    }
+
+    // Function to get the bytes used by the low side
+    std::size_t low_used() const {
+        return low_next - heap;
+    }
+
+    // Function to get the bytes used by the high side
+    std::size_t high_used() const {
+        return heap_end - high_next;
+    }
+
+private:
+    char* heap;                     // Pointer to the start of the heap
+    char* heap_end;                 // Pointer to the end of the heap
+    char* low_next;                 // Bump pointer of the low (upward) side
+    char* high_next;                // Bump pointer of the high (downward) side
+    std::size_t low_count;          // Active allocations on the low side
+    std::size_t high_count;         // Active allocations on the high side
+    std::size_t total_allocations;  // Total number of allocations ever made
+    std::mutex alloc_mutex;         // Mutex for thread-safety
+
+    // Function to align a pointer forward to the required alignment
+    static char* align_up(char* ptr, std::size_t alignment) {
+        std::size_t mask = alignment - 1;                   // Create alignment mask
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & mask; // Calculate misalignment
+        if (misalignment != 0) {
+            ptr += (alignment - misalignment); // Adjust the pointer forward to align
+        }
+        return ptr;
+    }
+
+    // Function to align a pointer backward to the required alignment
+    static char* align_down(char* ptr, std::size_t alignment) {
+        std::size_t mask = alignment - 1;                   // Create alignment mask
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & mask; // Calculate misalignment
+        return ptr - misalignment; // Adjust the pointer backward to align
+    }
+};
+
+#endif // DOUBLEENDEDBUMPALLOCATOR_HPP
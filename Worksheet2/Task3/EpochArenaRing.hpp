@@ -0,0 +1,153 @@
+#ifndef EPOCHARENARING_HPP
+#define EPOCHARENARING_HPP
+
+#include <atomic>   // For the epoch counter and reader pins
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint64_t
+#include <memory>   // For std::unique_ptr
+#include <thread>   // For std::this_thread::yield
+
+// Ring of bump arenas with epoch-based reclamation for read-mostly data.
+//
+// dealloc() reuses memory immediately, so an arena cannot be reset while
+// other threads may still read objects in it. EpochArenaRing keeps
+// ArenaCount arenas (two gives classic double buffering). Epoch e lives in
+// arena e % ArenaCount:
+//
+//   - A writer calls begin_update() to get the arena for the next epoch,
+//     builds the new version of the data in it and publish()es its root.
+//   - A reader calls pin() to get a ReadGuard for the current epoch and reads
+//     through guard.root<T>() for as long as the guard lives.
+//   - Before an arena is reused for a new epoch it waits until every reader
+//     pinned to its old epoch has left, then resets it in one rollback.
+//
+// Readers never block and touch only one atomic counter per pin, so there are
+// no per-object reference counts. Readers of the current epoch never hold up
+// a writer; only readers still pinned ArenaCount - 1 epochs back do.
+// Writers must be serialized by the caller (typically one rebuild thread).
+//
+// Allocator must be constructible from a heap size and support mark() and
+// rollback(), as the BasicBumpAllocator family does.
+template <typename Allocator, std::size_t ArenaCount = 2>
+class EpochArenaRing {
+    static_assert(ArenaCount >= 2, "Readers of the current epoch need an arena of their own");
+
+    // One arena of the ring
+    struct Slot {
+        std::unique_ptr<Allocator> arena;                   // Memory for one epoch
+        typename Allocator::Marker empty;                   // Marker of the empty arena
+        std::atomic<const void*> root{nullptr};             // Root published for the epoch
+        alignas(64) std::atomic<std::size_t> readers{0};    // Readers pinned to the epoch
+    };
+
+public:
+    // Reader's pin on one epoch; the epoch's arena is not reset while the guard lives
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : slot(other.slot), pinned_epoch(other.pinned_epoch) {
+            other.slot = nullptr;
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        // Destructor: Leaves the epoch
+        ~ReadGuard() {
+            if (slot != nullptr) {
+                slot->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // Template function to get the root published for the pinned epoch (nullptr if none)
+        template <typename T>
+        const T* root() const {
+            return static_cast<const T*>(slot->root.load(std::memory_order_acquire));
+        }
+
+        std::uint64_t epoch() const { return pinned_epoch; }
+
+    private:
+        friend class EpochArenaRing;
+
+        Slot* slot;                     // Arena slot the reader is pinned to
+        std::uint64_t pinned_epoch;     // Epoch the reader is pinned to
+
+        ReadGuard(Slot* slot, std::uint64_t epoch) : slot(slot), pinned_epoch(epoch) {}
+    };
+
+    // Constructor: Creates ArenaCount arenas of arena_size bytes; epoch 0 starts with no root
+    explicit EpochArenaRing(std::size_t arena_size) : current_epoch(0) {
+        for (std::size_t i = 0; i < ArenaCount; ++i) {
+            slots[i].arena.reset(new Allocator(arena_size));
+            slots[i].empty = slots[i].arena->mark(); // Position to roll back to on reuse
+        }
+    }
+
+    EpochArenaRing(const EpochArenaRing&) = delete;
+    EpochArenaRing& operator=(const EpochArenaRing&) = delete;
+
+    // Function to pin the current epoch (lock-free; retries only if a publish races with it)
+    ReadGuard pin() {
+        for (;;) {
+            std::uint64_t epoch = current_epoch.load(std::memory_order_seq_cst);
+            Slot& slot = slots[epoch % ArenaCount];
+            slot.readers.fetch_add(1, std::memory_order_seq_cst);
+
+            // The writer checks readers after publishing a newer epoch, so if the
+            // epoch is still current here the slot cannot be reset under us
+            if (current_epoch.load(std::memory_order_seq_cst) == epoch) {
+                return ReadGuard(&slot, epoch);
+            }
+            slot.readers.fetch_sub(1, std::memory_order_release); // Raced with a publish, try again
+        }
+    }
+
+    // Function to get the arena for the next epoch, waiting for its old readers to leave.
+    // The arena is reset before it is returned.
+    Allocator& begin_update() {
+        Allocator* arena = try_begin_update();
+        while (arena == nullptr) {
+            std::this_thread::yield(); // Readers of an old epoch are still inside
+            arena = try_begin_update();
+        }
+        return *arena;
+    }
+
+    // Function to get the reset arena for the next epoch, or nullptr if old readers are still inside it
+    Allocator* try_begin_update() {
+        Slot& slot = next_slot();
+        if (slot.readers.load(std::memory_order_seq_cst) != 0) {
+            return nullptr;
+        }
+        slot.root.store(nullptr, std::memory_order_relaxed);
+        slot.arena->rollback(slot.empty); // Bulk-free the old epoch in O(1)
+        return slot.arena.get();
+    }
+
+    // Function to publish root (built in the arena from begin_update) as the next epoch
+    void publish(const void* root) {
+        next_slot().root.store(root, std::memory_order_release);
+        current_epoch.fetch_add(1, std::memory_order_seq_cst); // New readers now pin the new epoch
+    }
+
+    // Function to get the current epoch
+    std::uint64_t epoch() const {
+        return current_epoch.load(std::memory_order_acquire);
+    }
+
+    // Function to get the number of readers pinned to the arena of epoch (for tests and monitoring)
+    std::size_t readers(std::uint64_t epoch) const {
+        return slots[epoch % ArenaCount].readers.load(std::memory_order_acquire);
+    }
+
+private:
+    Slot slots[ArenaCount];                             // Arenas, epoch e in slots[e % ArenaCount]
+    alignas(64) std::atomic<std::uint64_t> current_epoch; // Epoch new readers pin
+
+    Slot& next_slot() {
+        return slots[(current_epoch.load(std::memory_order_seq_cst) + 1) % ArenaCount];
+    }
+};
+
+#endif // EPOCHARENARING_HPP
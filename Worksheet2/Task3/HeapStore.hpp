@@ -0,0 +1,25 @@
+#ifndef HEAPSTORE_HPP
+#define HEAPSTORE_HPP
+
+#include <cstddef>      // For size_t
+#include <utility>      // For std::move and std::swap
+#include "MmapHeap.hpp" // For the mmap-backed alternative
+#include "BasicBumpAllocator.hpp" // For NewHeap
+
+// Backing store that is either a new char[] heap or an MmapHeap, chosen at
+// construction. Used by BumpAllocatorUpwards/Downwards so both
+// BumpAllocatorUpwards(size) and BumpAllocatorUpwards(MmapHeap(...)) work.
+class HeapStore {
+public:
+    explicit HeapStore(std::size_t size) : owned(size) {}
+    HeapStore(MmapHeap mapped_heap) : mapped(std::move(mapped_heap)) {}
+
+    char* data() const { return mapped.data() ? mapped.data() : owned.data(); }
+    std::size_t size() const { return mapped.data() ? mapped.size() : owned.size(); }
+
+private:
+    NewHeap owned;    // new char[] heap, empty when mapped is used
+    MmapHeap mapped;  // mmap-backed heap, empty when the heap came from new char[]
+};
+
+#endif // HEAPSTORE_HPP
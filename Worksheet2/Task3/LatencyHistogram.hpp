@@ -0,0 +1,146 @@
+// LatencyHistogram.hpp
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+// Log-linear latency histogram in the style of HdrHistogram.
+//
+// Values below sub_bucket_count are counted exactly. Above that, every power
+// of two [2^k, 2^(k+1)) is split into sub_bucket_count equal buckets, so a
+// value is known to within 1 / sub_bucket_count (about 3 %) of itself, from
+// nanoseconds up to the full 64-bit range, in a fixed 15 KB table. record()
+// is a bit scan, a shift and an increment, so it can sit inside the timed
+// loop. Each thread records into its own histogram, and merge() adds them up
+// afterwards without any synchronization on the hot path.
+class LatencyHistogram {
+public:
+    static constexpr unsigned sub_bucket_bits = 5;                          // log2 of the buckets per power of two
+    static constexpr std::uint64_t sub_bucket_count = 1ull << sub_bucket_bits;
+    static constexpr std::size_t bucket_count = sub_bucket_count * (64 - sub_bucket_bits + 1);
+
+    LatencyHistogram() { reset(); }
+
+    // Function to count one value
+    void record(std::uint64_t value) {
+        record(value, 1);
+    }
+
+    // Function to count a value count times
+    void record(std::uint64_t value, std::uint64_t count) {
+        counts[bucket(value)] += count;
+        total += count;
+        sum += static_cast<double>(value) * static_cast<double>(count);
+        if (value < lowest) {
+            lowest = value;
+        }
+        if (value > highest) {
+            highest = value;
+        }
+    }
+
+    // Function to add every value recorded in other (e.g. another thread's histogram)
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        sum += other.sum;
+        if (other.lowest < lowest) {
+            lowest = other.lowest;
+        }
+        if (other.highest > highest) {
+            highest = other.highest;
+        }
+    }
+
+    // Function to forget every value
+    void reset() {
+        for (std::uint64_t& count : counts) {
+            count = 0;
+        }
+        total = 0;
+        sum = 0;
+        lowest = std::numeric_limits<std::uint64_t>::max();
+        highest = 0;
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t min() const { return total ? lowest : 0; }
+    std::uint64_t max() const { return highest; }
+    double mean() const { return total ? sum / static_cast<double>(total) : 0; }
+
+    // Function to get the value below or at which percent % of the values lie.
+    // Returns the top of the bucket holding that rank (never above max()), so it is
+    // at most about 3 % above the true value and never below it.
+    std::uint64_t percentile(double percent) const {
+        if (total == 0) {
+            return 0;
+        }
+        double wanted = percent / 100.0 * static_cast<double>(total);
+        std::uint64_t rank = wanted < 1 ? 1 : static_cast<std::uint64_t>(wanted + 0.999999); // Ceiling, 1-based
+        if (rank > total) {
+            rank = total;
+        }
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                std::uint64_t top = bucket_top(i);
+                return top < highest ? top : highest;
+            }
+        }
+        return highest;
+    }
+
+    // Function to print count, mean and the tail percentiles on one line
+    void print(std::ostream& out, const char* name, const char* unit = "ns") const {
+        out << name << ": p50 " << percentile(50) << ", p90 " << percentile(90) << ", p99 " << percentile(99)
+            << ", p99.9 " << percentile(99.9) << ", p99.99 " << percentile(99.99) << ", max " << max() << " " << unit
+            << " (mean " << mean() << ", " << count() << " calls)\n";
+    }
+
+    // Function to get the bucket of a value
+    static std::size_t bucket(std::uint64_t value) {
+        if (value < sub_bucket_count) {
+            return static_cast<std::size_t>(value); // Exact
+        }
+        unsigned shift = highest_bit(value) - sub_bucket_bits;   // Bucket width is 2^shift
+        return static_cast<std::size_t>(sub_bucket_count * (shift + 1) + ((value >> shift) - sub_bucket_count));
+    }
+
+    // Function to get the largest value that falls into bucket index
+    static std::uint64_t bucket_top(std::size_t index) {
+        if (index < sub_bucket_count) {
+            return index;
+        }
+        std::uint64_t shift = index / sub_bucket_count - 1;
+        std::uint64_t mantissa = sub_bucket_count + index % sub_bucket_count;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+private:
+    std::uint64_t counts[bucket_count]; // Values per bucket
+    std::uint64_t total;                // Values recorded
+    double sum;                         // Sum of the values, for the mean
+    std::uint64_t lowest;               // Smallest value recorded
+    std::uint64_t highest;              // Largest value recorded
+
+    // Function to get the index of the highest set bit of a non-zero value
+    static unsigned highest_bit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+};
+
+#endif // LATENCYHISTOGRAM_HPP
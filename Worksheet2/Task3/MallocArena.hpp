@@ -0,0 +1,106 @@
+#ifndef MALLOCARENA_HPP
+#define MALLOCARENA_HPP
+
+#include <cstddef>  // For size_t and max_align_t
+#include <cstdlib>  // For malloc, aligned_alloc, realloc and free
+#include <cstring>  // For std::memcpy
+#include <vector>   // For the live block list
+
+// malloc behind the bump allocator interface (alloc_bytes, resize_last, dealloc, mark, rollback),
+// as a baseline for trace replays and workload sweeps. Blocks are freed when the
+// allocation count returns to zero or a rollback passes them, which is exactly
+// when a bump allocator would reuse their memory.
+struct MallocArena {
+    struct Marker {
+        std::size_t blocks = 0;           // Blocks allocated when the marker was taken
+        std::size_t allocation_count = 0; // Active allocations when the marker was taken
+    };
+
+    // Constructor: The heap size is ignored; malloc grows as needed
+    explicit MallocArena(std::size_t) {}
+
+    // Destructor: Frees every block still live
+    ~MallocArena() {
+        release(0);
+    }
+
+    MallocArena(const MallocArena&) = delete;
+    MallocArena& operator=(const MallocArena&) = delete;
+
+    // Function to allocate size bytes; alignments above max_align_t use aligned_alloc
+    void* alloc_bytes(std::size_t size, std::size_t alignment) {
+        void* block = allocate(size, alignment);
+        if (block != nullptr) {
+            blocks.push_back(block);
+            allocation_count++;
+        }
+        return block;
+    }
+
+    // Function to resize a block like BasicBumpAllocator::resize_last: the newest block is
+    // reallocated; any other block keeps its place when it shrinks and is copied into a new
+    // block when it grows, which does not count as another allocation, and the original
+    // stays until a reset or rollback frees it
+    void* resize_last(void* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment) {
+        if (ptr != nullptr && !blocks.empty() && ptr == blocks.back()) {
+            void* block = alignment <= alignof(std::max_align_t) && new_size != 0 ? std::realloc(ptr, new_size) : nullptr;
+            if (block == nullptr) {
+                block = allocate(new_size, alignment);
+                if (block == nullptr) {
+                    return nullptr;
+                }
+                std::memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+                std::free(ptr);
+            }
+            blocks.back() = block;
+            return block;
+        }
+        if (ptr != nullptr && new_size <= old_size) {
+            return ptr;
+        }
+        void* block = allocate(new_size, alignment);
+        if (block != nullptr) {
+            if (ptr != nullptr) {
+                std::memcpy(block, ptr, old_size);
+            } else {
+                allocation_count++;
+            }
+            blocks.push_back(block);
+        }
+        return block;
+    }
+
+    // Function to deallocate (free every block once all allocations are deallocated)
+    void dealloc() {
+        if (allocation_count > 0 && --allocation_count == 0) {
+            release(0);
+        }
+    }
+
+    Marker mark() const { return Marker{blocks.size(), allocation_count}; }
+
+    // Function to free every block allocated since the marker was taken
+    void rollback(const Marker& marker) {
+        release(marker.blocks);
+        allocation_count = marker.allocation_count;
+    }
+
+private:
+    std::vector<void*> blocks;          // Live blocks in allocation order
+    std::size_t allocation_count = 0;   // Active allocations
+
+    static void* allocate(std::size_t size, std::size_t alignment) {
+        return alignment <= alignof(std::max_align_t)
+            ? std::malloc(size)
+            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void release(std::size_t keep) {
+        while (blocks.size() > keep) {
+            std::free(blocks.back());
+            blocks.pop_back();
+        }
+    }
+};
+
+#endif // MALLOCARENA_HPP
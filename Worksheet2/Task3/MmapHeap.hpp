@@ -0,0 +1,125 @@
+#ifndef MMAPHEAP_HPP
+#define MMAPHEAP_HPP
+
+#include <cstddef>    // For size_t
+#include <cstdint>    // For uintptr_t
+#include <new>        // For std::bad_alloc
+#include <sys/mman.h> // For mmap, munmap and madvise
+#include <unistd.h>   // For sysconf
+#include <utility>    // For std::move and std::swap
+
+// Options for an mmap-backed heap
+struct MmapOptions {
+    bool huge_pages = false;   // Try MAP_HUGETLB, fall back to MADV_HUGEPAGE, then normal pages
+    bool prefault = false;     // MAP_POPULATE: pay every page fault up front instead of on first touch
+    bool guard_pages = true;   // Inaccessible page before and after the heap to catch overruns
+};
+
+// Heap memory obtained directly from mmap instead of new char[].
+//
+// The whole range (heap plus guard pages) is first reserved with PROT_NONE,
+// then the usable middle is mapped read/write on top of it, so the guard pages
+// stay inaccessible and any access past either end faults immediately. Throws
+// std::bad_alloc if no mapping can be created.
+class MmapHeap {
+public:
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024; // x86-64 / arm64 default huge page
+
+    // Default constructor: empty heap
+    MmapHeap() : reservation(nullptr), reservation_size(0), heap(nullptr), heap_size(0), huge(false) {}
+
+    // Constructor: Maps at least size bytes with the given options
+    explicit MmapHeap(std::size_t size, MmapOptions options = MmapOptions()) : MmapHeap() {
+        std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t alignment = options.huge_pages ? huge_page_size : page;
+        std::size_t guard = options.guard_pages ? page : 0;
+
+        heap_size = round_up(size == 0 ? 1 : size, alignment);
+
+        // Reserve room for both guards plus slack to align the heap itself
+        reservation_size = guard + (alignment - page) + heap_size + guard;
+        void* reserved = mmap(nullptr, reservation_size, PROT_NONE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (reserved == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        reservation = static_cast<char*>(reserved);
+
+        char* start = reinterpret_cast<char*>(round_up(reinterpret_cast<std::uintptr_t>(reservation) + guard, alignment));
+
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+#ifdef MAP_POPULATE
+        if (options.prefault) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+
+        void* mapped = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (options.huge_pages) {
+            mapped = mmap(start, heap_size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+            huge = (mapped != MAP_FAILED);
+        }
+#endif
+        if (mapped == MAP_FAILED) {
+            // No reserved huge pages (the usual case): use normal pages
+            mapped = mmap(start, heap_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        }
+        if (mapped == MAP_FAILED) {
+            munmap(reservation, reservation_size);
+            throw std::bad_alloc();
+        }
+        heap = static_cast<char*>(mapped);
+
+#ifdef MADV_HUGEPAGE
+        if (options.huge_pages && !huge) {
+            // Ask for transparent huge pages instead; harmless if THP is disabled
+            huge = (madvise(heap, heap_size, MADV_HUGEPAGE) == 0);
+        }
+#endif
+    }
+
+    // Destructor: Unmaps the heap and its guard pages
+    ~MmapHeap() {
+        if (reservation != nullptr) {
+            munmap(reservation, reservation_size);
+        }
+    }
+
+    MmapHeap(const MmapHeap&) = delete;
+    MmapHeap& operator=(const MmapHeap&) = delete;
+
+    MmapHeap(MmapHeap&& other) noexcept : MmapHeap() {
+        swap(other);
+    }
+
+    MmapHeap& operator=(MmapHeap&& other) noexcept {
+        MmapHeap(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    char* data() const { return heap; }             // Start of the usable heap
+    std::size_t size() const { return heap_size; }  // Usable bytes (rounded up to the page size)
+    bool huge_pages() const { return huge; }        // Whether huge pages were obtained or requested from THP
+
+private:
+    char* reservation;              // Start of the whole mapping, including guards
+    std::size_t reservation_size;   // Size of the whole mapping
+    char* heap;                     // Start of the usable heap
+    std::size_t heap_size;          // Size of the usable heap
+    bool huge;                      // Huge pages in use
+
+    void swap(MmapHeap& other) noexcept {
+        std::swap(reservation, other.reservation);
+        std::swap(reservation_size, other.reservation_size);
+        std::swap(heap, other.heap);
+        std::swap(heap_size, other.heap_size);
+        std::swap(huge, other.huge);
+    }
+
+    static std::size_t round_up(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+};
+
+#endif // MMAPHEAP_HPP
@@ -0,0 +1,66 @@
+#ifndef OFFSETPTR_HPP
+#define OFFSETPTR_HPP
+
+#include <cstddef>  // For ptrdiff_t and nullptr_t
+#include <cstdint>  // For intptr_t
+
+// Self-relative pointer for structures stored inside an arena.
+//
+// Instead of an address, an offset_ptr stores the distance from its own
+// address to the target. As long as the pointer and its target move together
+// (the whole arena is copied to a file and mapped back at another address),
+// the distance stays the same and the pointer stays valid. A distance of 0
+// means null, since a pointer never usefully points at itself.
+//
+// Copying an offset_ptr recomputes the distance for the copy's own address,
+// so offset_ptrs can be assigned and passed around like raw pointers.
+template <typename T>
+class offset_ptr {
+public:
+    // Constructor: null pointer
+    offset_ptr() : offset(0) {}
+    offset_ptr(std::nullptr_t) : offset(0) {}
+
+    // Constructor: points at target
+    offset_ptr(T* target) : offset(distance_to(target)) {}
+
+    offset_ptr(const offset_ptr& other) : offset(distance_to(other.get())) {}
+
+    offset_ptr& operator=(const offset_ptr& other) {
+        offset = distance_to(other.get());
+        return *this;
+    }
+
+    offset_ptr& operator=(T* target) {
+        offset = distance_to(target);
+        return *this;
+    }
+
+    // Function to get the raw pointer at the current address
+    T* get() const {
+        if (offset == 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + offset);
+    }
+
+    T& operator*() const { return *get(); }
+    T* operator->() const { return get(); }
+    T& operator[](std::size_t index) const { return get()[index]; }
+    explicit operator bool() const { return offset != 0; }
+
+    bool operator==(const offset_ptr& other) const { return get() == other.get(); }
+    bool operator!=(const offset_ptr& other) const { return get() != other.get(); }
+
+private:
+    std::ptrdiff_t offset; // Bytes from this object to the target, 0 for null
+
+    std::ptrdiff_t distance_to(T* target) const {
+        if (target == nullptr) {
+            return 0;
+        }
+        return reinterpret_cast<std::intptr_t>(target) - reinterpret_cast<std::intptr_t>(this);
+    }
+};
+
+#endif // OFFSETPTR_HPP
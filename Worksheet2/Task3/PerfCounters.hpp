@@ -0,0 +1,163 @@
+// PerfCounters.hpp
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware performance counters for the calling thread, read through Linux perf_event_open.
+//
+// Each event is opened on its own, so a CPU or VM that lacks one event (dTLB
+// misses are often missing in VMs) still reports the others. When perf is not
+// usable at all - not Linux, a container without CAP_PERFMON, or
+// /proc/sys/kernel/perf_event_paranoid too high - available() is false,
+// error() says why and every reading is marked invalid; nothing throws.
+// Counts are scaled by time_enabled / time_running when the kernel had to
+// multiplex more events than the PMU has counters.
+class PerfCounters {
+public:
+    enum Event { cycles, instructions, l1d_misses, llc_misses, branch_misses, dtlb_misses, event_count };
+
+    // Counter values for one measured region
+    struct Reading {
+        double values[event_count] = {};  // Count per event (scaled for multiplexing)
+        bool valid[event_count] = {};     // Whether the event could be counted
+    };
+
+    // Function to get the display name of an event
+    static const char* name(Event event) {
+        static const char* const names[event_count] = {"cycles", "instructions", "L1d misses", "LLC misses", "branch misses", "dTLB misses"};
+        return names[event];
+    }
+
+    // Constructor: Opens every event it can for the calling thread (counting stays disabled until start())
+    PerfCounters() : failure(nullptr) {
+        for (int& fd : fds) {
+            fd = -1;
+        }
+#ifdef __linux__
+        static const std::uint32_t types[event_count] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+        static const std::uint64_t configs[event_count] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            cache_miss(PERF_COUNT_HW_CACHE_L1D),
+            cache_miss(PERF_COUNT_HW_CACHE_LL),
+            PERF_COUNT_HW_BRANCH_MISSES,
+            cache_miss(PERF_COUNT_HW_CACHE_DTLB)};
+
+        int first_error = 0;
+        for (int e = 0; e < event_count; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[e];
+            attr.config = configs[e];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;   // Allowed at perf_event_paranoid 2, and the allocators run in user space
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[e] < 0 && first_error == 0) {
+                first_error = errno;
+            }
+        }
+        if (!available()) {
+            failure = first_error == EACCES || first_error == EPERM
+                ? "perf_event_open not permitted (check /proc/sys/kernel/perf_event_paranoid or container capabilities)"
+                : first_error == ENOENT || first_error == ENOSYS || first_error == EOPNOTSUPP
+                ? "no hardware counters on this CPU or VM"
+                : "perf_event_open failed";
+        }
+#else
+        failure = "hardware counters need Linux perf_event_open";
+#endif
+    }
+
+    // Destructor: Closes every event
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool available(Event event) const { return fds[event] >= 0; }
+    const char* error() const { return failure; }   // Why no counter is available, nullptr if any is
+
+    // Function to zero and start every open counter
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    // Function to stop every open counter
+    void stop() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+    }
+
+    // Function to read the counts since the last start()
+    Reading read() const {
+        Reading reading;
+#ifdef __linux__
+        for (int e = 0; e < event_count; ++e) {
+            std::uint64_t data[3]; // value, time enabled, time running
+            if (fds[e] < 0 || ::read(fds[e], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+                continue; // Not open, or never scheduled on the PMU
+            }
+            reading.values[e] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            reading.valid[e] = true;
+        }
+#endif
+        return reading;
+    }
+
+private:
+    int fds[event_count];   // One perf event per counter, -1 if it could not be opened
+    const char* failure;    // Reason no counter is available
+
+#ifdef __linux__
+    // Function to build the config of a read-miss cache event
+    static constexpr std::uint64_t cache_miss(std::uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+};
+
+#endif // PERFCOUNTERS_HPP
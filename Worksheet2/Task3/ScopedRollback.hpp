@@ -0,0 +1,32 @@
+#ifndef SCOPEDROLLBACK_HPP
+#define SCOPEDROLLBACK_HPP
+
+// RAII guard that rolls a bump allocator back to where it was when the guard
+// was created. Works with any allocator offering mark()/rollback(), such as
+// BumpAllocatorUpwards and BumpAllocatorDownwards:
+//
+//     {
+//         ScopedRollback<BumpAllocatorUpwards> frame(allocator);
+//         int* scratch = allocator.alloc<int>(100); // Released when frame ends
+//     }
+//
+// Guards may be nested; they must end in reverse order of creation, which
+// normal scoping guarantees.
+template <typename Allocator>
+class ScopedRollback {
+public:
+    explicit ScopedRollback(Allocator& allocator) : allocator(allocator), marker(allocator.mark()) {}
+
+    ~ScopedRollback() {
+        allocator.rollback(marker); // Release everything allocated inside the scope
+    }
+
+    ScopedRollback(const ScopedRollback&) = delete;
+    ScopedRollback& operator=(const ScopedRollback&) = delete;
+
+private:
+    Allocator& allocator;                  // Allocator being rolled back
+    typename Allocator::Marker marker;     // Position saved on construction
+};
+
+#endif // SCOPEDROLLBACK_HPP
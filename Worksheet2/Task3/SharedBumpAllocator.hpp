@@ -0,0 +1,325 @@
+#ifndef SHAREDBUMPALLOCATOR_HPP
+#define SHAREDBUMPALLOCATOR_HPP
+
+#include <atomic>       // For the packed bump state shared between processes
+#include <cerrno>       // For errno
+#include <chrono>       // For the attach timeout
+#include <cstddef>      // For size_t
+#include <cstdint>      // For uint64_t and uintptr_t
+#include <fcntl.h>      // For O_CREAT, O_EXCL and O_RDWR
+#include <limits>       // For the heap size limit
+#include <new>          // For placement new
+#include <sys/mman.h>   // For shm_open, shm_unlink, mmap and munmap
+#include <sys/stat.h>   // For fstat
+#include <system_error> // For std::system_error
+#include <thread>       // For std::this_thread::sleep_for
+#include <unistd.h>     // For ftruncate and close
+#include <utility>      // For std::swap
+
+// Upward bump allocator whose heap is a POSIX shared-memory segment.
+//
+// Every process that constructs a SharedBumpAllocator with the same name maps
+// the same segment (shm_open + mmap), so data built by one worker can be read
+// by all of them instead of being built N times. The segment starts with a
+// one-page header holding the bump state; the heap follows it.
+//
+// As in BumpAllocatorAtomic, the allocation count (high 32 bits) and the bump
+// offset (low 32 bits) are packed into one lock-free 64-bit atomic, which now
+// lives in the header, so alloc() and dealloc() are safe across processes as
+// well as threads. Because every process maps the segment at a different
+// address, link shared structures with offset_ptr (OffsetPtr.hpp) or pass
+// offsets (offset_of / at), never raw pointers. publish_root() gives the other
+// processes an entry point.
+//
+// Process-shared reset and rollback semantics:
+//   - The allocation count is shared. dealloc() from any process decrements
+//     it, and when it reaches zero the offset returns to 0 for everyone, so
+//     pointers still held by another process then refer to reusable memory,
+//     exactly as with threads in the in-process allocators.
+//   - rollback() only succeeds if no other process (or thread) changed the
+//     bump state since this handle's last allocation, i.e. this handle's
+//     allocations are still on top. Otherwise it returns false and changes
+//     nothing. mark() and rollback() should be used by one thread per handle.
+//   - Unmapping (the destructor) never frees the segment; remove() unlinks
+//     the name, and the memory is released when the last process unmaps it.
+//
+// Constructors throw std::system_error if the segment cannot be created or attached.
+class SharedBumpAllocator {
+public:
+    // Largest heap the packed 32-bit offset can address
+    static constexpr std::size_t max_heap_size = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t header_bytes = 4096; // Header page in front of the heap
+
+    // Saved bump state, see mark() and rollback()
+    struct Marker {
+        std::uint64_t state; // Packed (allocation count, bump offset) when the marker was taken
+    };
+
+    // Constructor: Creates the segment name with heap_size bytes of heap, or attaches to it if it already exists
+    SharedBumpAllocator(const char* name, std::size_t heap_size) : SharedBumpAllocator() {
+        if (heap_size > max_heap_size) {
+            heap_size = max_heap_size;   // Clamp to what the packed offset can represent
+        }
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 && errno == EEXIST) {
+            attach(name); // Another process created it first
+            return;
+        }
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open");
+        }
+        if (ftruncate(fd, static_cast<off_t>(header_bytes + heap_size)) != 0) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name);
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+        map(fd, header_bytes + heap_size);
+
+        // Initialize the header, then let attaching processes in
+        header = new (segment) Header();
+        header->heap_size = heap_size;
+        header->state.store(0, std::memory_order_relaxed);  // Offset 0, no active allocations
+        header->root.store(0, std::memory_order_relaxed);   // No published root yet
+        header->ready.store(header_magic, std::memory_order_release);
+        init_heap();
+    }
+
+    // Constructor: Attaches to an existing segment, waiting briefly for its creator to initialize it
+    explicit SharedBumpAllocator(const char* name) : SharedBumpAllocator() {
+        attach(name);
+    }
+
+    // Destructor: Unmaps the segment (it stays alive until remove() and the last unmap)
+    ~SharedBumpAllocator() {
+        if (segment != nullptr) {
+            munmap(segment, segment_size);
+        }
+    }
+
+    SharedBumpAllocator(const SharedBumpAllocator&) = delete;
+    SharedBumpAllocator& operator=(const SharedBumpAllocator&) = delete;
+
+    SharedBumpAllocator(SharedBumpAllocator&& other) noexcept : SharedBumpAllocator() {
+        swap(other);
+    }
+
+    SharedBumpAllocator& operator=(SharedBumpAllocator&& other) noexcept {
+        SharedBumpAllocator(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    // Function to unlink the segment name; returns false if it did not exist
+    static bool remove(const char* name) {
+        return shm_unlink(name) == 0;
+    }
+
+    // Template function for memory allocation (lock-free, shared across processes)
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        if (num_objects > total_size / sizeof(T)) {
+            return nullptr;                                 // Can never fit, avoid overflow below
+        }
+        return static_cast<T*>(alloc_bytes(sizeof(T) * num_objects, alignof(T)));
+    }
+
+    // Function for raw memory allocation with a power-of-two alignment (up to the page size)
+    void* alloc_bytes(std::size_t required_size, std::size_t alignment) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > header_bytes) {
+            return nullptr; // The mask arithmetic needs a power of two
+        }
+        std::uint64_t current = header->state.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t offset = unpack_offset(current);
+            std::size_t count = unpack_count(current);
+
+            // Align the offset by moving it forward (the heap is page-aligned in every process)
+            std::size_t aligned_offset = (offset + alignment - 1) & ~(alignment - 1);
+
+            // Check if the aligned offset plus required size is within bounds
+            if (aligned_offset > total_size || required_size > total_size - aligned_offset) {
+                return nullptr; // Return null pointer if allocation fails
+            }
+
+            std::uint64_t desired = pack(count + 1, aligned_offset + required_size);
+            if (header->state.compare_exchange_weak(current, desired,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed)) {
+                last_state.store(desired, std::memory_order_relaxed);
+                return heap + aligned_offset;
+            }
+            // Another thread or process moved the bump offset, retry with the fresh state in current
+        }
+    }
+
+    // Function to deallocate memory (resets the shared heap when every process's allocations are freed)
+    void dealloc() {
+        std::uint64_t current = header->state.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t count = unpack_count(current);
+            if (count > 0) {
+                count--; // Decrease allocation count
+            }
+
+            // Reset the allocator if all allocations are deallocated
+            std::size_t offset = (count == 0) ? 0 : unpack_offset(current);
+
+            if (header->state.compare_exchange_weak(current, pack(count, offset),
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    // Function to save the current shared bump state
+    Marker mark() {
+        std::uint64_t current = header->state.load(std::memory_order_acquire);
+        last_state.store(current, std::memory_order_relaxed);
+        return Marker{current};
+    }
+
+    // Function to release this handle's allocations made since the marker.
+    // Returns false (and changes nothing) if anyone else allocated or freed in between.
+    bool rollback(const Marker& marker) {
+        std::uint64_t expected = last_state.load(std::memory_order_relaxed);
+        if (!header->state.compare_exchange_strong(expected, marker.state,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed)) {
+            return false;
+        }
+        last_state.store(marker.state, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Function to publish the entry point of a shared structure for other processes
+    void publish_root(const void* root) {
+        header->root.store(offset_of(root) + 1, std::memory_order_release); // 0 means none
+    }
+
+    // Template function to get the published root, or nullptr if none was published yet
+    template <typename T>
+    T* root() const {
+        std::uint64_t stored = header->root.load(std::memory_order_acquire);
+        return stored == 0 ? nullptr : at<T>(static_cast<std::size_t>(stored - 1));
+    }
+
+    // Function to turn a pointer into the heap into an offset that is valid in every process
+    std::size_t offset_of(const void* ptr) const {
+        return static_cast<const char*>(ptr) - heap;
+    }
+
+    // Template function to turn an offset from offset_of back into a pointer in this process
+    template <typename T>
+    T* at(std::size_t offset) const {
+        return reinterpret_cast<T*>(heap + offset);
+    }
+
+    // Function to get the remaining memory available
+    std::size_t remaining_memory() const {
+        return total_size - unpack_offset(header->state.load(std::memory_order_acquire));
+    }
+
+    // Function to get the number of active allocations across all processes
+    std::size_t allocation_count() const {
+        return unpack_count(header->state.load(std::memory_order_acquire));
+    }
+
+private:
+    static constexpr std::uint32_t header_magic = 0x53484d42; // "SHMB", set once the header is initialized
+
+    // Header at the start of the segment, shared by every process
+    struct Header {
+        std::atomic<std::uint32_t> ready;                // header_magic once initialized
+        std::uint64_t heap_size;                         // Bytes of heap after the header
+        alignas(64) std::atomic<std::uint64_t> state;    // Packed (allocation count, bump offset)
+        alignas(64) std::atomic<std::uint64_t> root;     // Offset of the published root plus one, 0 for none
+    };
+    static_assert(sizeof(Header) <= header_bytes, "Header must fit in its page");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared atomics must be lock-free to work across processes");
+
+    char* segment;                              // Start of the mapping (the header)
+    std::size_t segment_size;                   // Size of the mapping
+    Header* header;                             // Shared header
+    char* heap;                                 // Start of the heap in this process
+    std::size_t total_size;                     // Total size of the heap
+    std::atomic<std::uint64_t> last_state;      // Shared state after this handle's last allocation, for rollback()
+
+    // Default constructor: unmapped handle
+    SharedBumpAllocator()
+        : segment(nullptr), segment_size(0), header(nullptr), heap(nullptr), total_size(0), last_state(0) {}
+
+    // Function to attach to an existing segment once its creator has sized and initialized it
+    void attach(const char* name) {
+        int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open");
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        struct stat segment_stat;
+        while (fstat(fd, &segment_stat) == 0 && static_cast<std::size_t>(segment_stat.st_size) < header_bytes) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                close(fd);
+                throw std::system_error(ETIMEDOUT, std::generic_category(), "shared arena was never sized");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Creator has not called ftruncate yet
+        }
+        map(fd, static_cast<std::size_t>(segment_stat.st_size));
+
+        header = reinterpret_cast<Header*>(segment);
+        while (header->ready.load(std::memory_order_acquire) != header_magic) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                throw std::system_error(ETIMEDOUT, std::generic_category(), "shared arena was never initialized");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Creator is still writing the header
+        }
+        if (header->heap_size > segment_size - header_bytes) {
+            throw std::system_error(EINVAL, std::generic_category(), "shared arena header does not match the segment");
+        }
+        init_heap();
+        last_state.store(header->state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    // Function to map size bytes of the segment behind fd; closes fd
+    void map(int fd, std::size_t size) {
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        close(fd); // The mapping keeps the segment alive
+        if (mapped == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        segment = static_cast<char*>(mapped);
+        segment_size = size;
+    }
+
+    void init_heap() {
+        heap = segment + header_bytes;                          // Heap follows the header page
+        total_size = static_cast<std::size_t>(header->heap_size);
+    }
+
+    void swap(SharedBumpAllocator& other) noexcept {
+        std::swap(segment, other.segment);
+        std::swap(segment_size, other.segment_size);
+        std::swap(header, other.header);
+        std::swap(heap, other.heap);
+        std::swap(total_size, other.total_size);
+        std::uint64_t state = last_state.load(std::memory_order_relaxed);
+        last_state.store(other.last_state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.last_state.store(state, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t pack(std::size_t count, std::size_t offset) {
+        return (static_cast<std::uint64_t>(count) << 32) | static_cast<std::uint64_t>(offset);
+    }
+
+    static std::size_t unpack_count(std::uint64_t packed) {
+        return static_cast<std::size_t>(packed >> 32);
+    }
+
+    static std::size_t unpack_offset(std::uint64_t packed) {
+        return static_cast<std::size_t>(packed & 0xFFFFFFFFu);
+    }
+};
+
+#endif // SHAREDBUMPALLOCATOR_HPP
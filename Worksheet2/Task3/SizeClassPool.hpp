@@ -0,0 +1,150 @@
+#ifndef SIZECLASSPOOL_HPP
+#define SIZECLASSPOOL_HPP
+
+#include <cstddef>  // For size_t and max_align_t
+#include <mutex>    // For thread-safety using std::mutex
+
+// Segregated size-class pool layered on a bump allocator.
+//
+// Requests are rounded up to a power-of-two size class (16 bytes to 4 KiB)
+// and served from an intrusive free list for that class; a freed block stores
+// the free-list link in its own memory, so free(ptr, size) and the common
+// allocation path are both O(1). When a class's list is empty the pool carves
+// a fresh slab from the underlying arena with alloc_bytes. Requests above the
+// largest class go straight to the arena and are only reclaimed by reset().
+//
+// Every block is aligned to alignof(std::max_align_t).
+template <typename Allocator>
+class SizeClassPool {
+public:
+    static constexpr std::size_t min_class_size = 16;      // Smallest size class
+    static constexpr std::size_t max_class_size = 4096;    // Largest size class
+    static constexpr std::size_t class_count = 9;          // 16, 32, ... 4096
+
+    // Constructor: slab_size is how much the pool carves from the arena at a time
+    SizeClassPool(Allocator& arena_allocator, std::size_t slab_size = 16 * 1024)
+        : arena(arena_allocator), slab_size(slab_size), arena_allocations(0) {
+        for (std::size_t i = 0; i < class_count; ++i) {
+            free_lists[i] = nullptr;
+        }
+    }
+
+    // Destructor: Returns everything to the arena
+    ~SizeClassPool() {
+        reset();
+    }
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    // Function to allocate a block of at least size bytes
+    void* alloc(std::size_t size) {
+        std::lock_guard<std::mutex> guard(pool_mutex); // Ensure thread-safety
+
+        if (size > max_class_size) {
+            return alloc_from_arena(size); // Too big for any class
+        }
+
+        std::size_t index = class_index(size);
+        FreeBlock* block = free_lists[index];
+        if (block == nullptr) {
+            if (!refill(index)) {
+                return nullptr; // Arena is out of memory
+            }
+            block = free_lists[index];
+        }
+        free_lists[index] = block->next; // Pop from the class's free list
+        return block;
+    }
+
+    // Template function to allocate memory for num_objects objects of type T
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "SizeClassPool blocks are max_align_t aligned");
+        return static_cast<T*>(alloc(sizeof(T) * num_objects));
+    }
+
+    // Function to return a block; size must match the size it was allocated with
+    void free(void* ptr, std::size_t size) {
+        if (ptr == nullptr || size > max_class_size) {
+            return; // Large blocks stay in the arena until reset()
+        }
+        std::lock_guard<std::mutex> guard(pool_mutex); // Ensure thread-safety
+
+        std::size_t index = class_index(size);
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_lists[index]; // Push onto the class's free list
+        free_lists[index] = block;
+    }
+
+    // Function to drop every block and return all slabs to the arena
+    void reset() {
+        std::lock_guard<std::mutex> guard(pool_mutex); // Ensure thread-safety
+
+        for (std::size_t i = 0; i < class_count; ++i) {
+            free_lists[i] = nullptr;
+        }
+        // Each slab or large block counts as one allocation in the arena
+        for (; arena_allocations > 0; --arena_allocations) {
+            arena.dealloc();
+        }
+    }
+
+    // Function to get the size class a request of size bytes is rounded up to
+    static std::size_t class_size(std::size_t size) {
+        return min_class_size << class_index(size);
+    }
+
+private:
+    // Link stored inside each free block
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    Allocator& arena;                      // Bump allocator the slabs come from
+    std::size_t slab_size;                 // Bytes carved from the arena per refill
+    std::size_t arena_allocations;         // Slabs and large blocks taken from the arena
+    FreeBlock* free_lists[class_count];    // One intrusive free list per size class
+    std::mutex pool_mutex;                 // Mutex for thread-safety
+
+    // Function to map a size to its power-of-two class index
+    static std::size_t class_index(std::size_t size) {
+        std::size_t index = 0;
+        std::size_t block_size = min_class_size;
+        while (block_size < size) {
+            block_size <<= 1;
+            index++;
+        }
+        return index;
+    }
+
+    // Function to carve a new slab for one size class and thread it onto the free list
+    bool refill(std::size_t index) {
+        std::size_t block_size = min_class_size << index;
+        std::size_t bytes = slab_size < block_size ? block_size : slab_size;
+        std::size_t blocks = bytes / block_size;
+
+        char* slab = static_cast<char*>(alloc_from_arena(blocks * block_size));
+        if (slab == nullptr) {
+            return false;
+        }
+
+        // Link the blocks back to front so they are handed out in address order
+        for (std::size_t i = blocks; i > 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+            block->next = free_lists[index];
+            free_lists[index] = block;
+        }
+        return true;
+    }
+
+    void* alloc_from_arena(std::size_t size) {
+        void* ptr = arena.alloc_bytes(size, alignof(std::max_align_t));
+        if (ptr != nullptr) {
+            arena_allocations++;
+        }
+        return ptr;
+    }
+};
+
+#endif // SIZECLASSPOOL_HPP
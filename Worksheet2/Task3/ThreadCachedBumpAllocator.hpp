@@ -0,0 +1,187 @@
+#ifndef THREADCACHEDBUMPALLOCATOR_HPP
+#define THREADCACHEDBUMPALLOCATOR_HPP
+
+#include <atomic>         // For the chunk counter and allocator ids
+#include <cstddef>        // For size_t and max_align_t
+#include <cstdint>        // For uintptr_t and uint64_t
+#include <memory>         // For std::unique_ptr
+#include <mutex>          // For the cache registry
+#include <thread>         // For std::this_thread::get_id
+#include <unordered_map>  // For the per-thread cache lookup
+#include <vector>         // For the cache registry
+
+// Thread-local front end for a shared bump allocator.
+//
+// Each thread grabs a large chunk from the shared Parent allocator and bump
+// allocates from it privately, so the fast path touches only memory owned by
+// the calling thread. The Parent is only visited (and only locked, if it locks)
+// when a thread's chunk runs out. Parent must be thread-safe and provide
+// alloc<T>(n) and dealloc(), e.g. BumpAllocatorUpwards or BumpAllocatorAtomic.
+template <typename Parent>
+class ThreadCachedBumpAllocator {
+public:
+    // Constructor: chunk_size is how much each thread takes from the parent at a time
+    ThreadCachedBumpAllocator(Parent& parent_allocator, std::size_t chunk_size = 64 * 1024)
+        : parent(parent_allocator), chunk_size(chunk_size), id(next_id()), chunks_acquired(0) {}
+
+    // Destructor: Returns every chunk to the parent
+    ~ThreadCachedBumpAllocator() {
+        reset();
+    }
+
+    ThreadCachedBumpAllocator(const ThreadCachedBumpAllocator&) = delete;
+    ThreadCachedBumpAllocator& operator=(const ThreadCachedBumpAllocator&) = delete;
+
+    // Template function for memory allocation from the calling thread's chunk
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        Cache& cache = local_cache();
+
+        std::size_t required_size = sizeof(T) * num_objects; // Calculate required memory size
+        std::size_t alignment = alignof(T);                 // Get alignment for the data type
+
+        // Fast path: bump inside the thread's own chunk, no shared state touched
+        if (cache.next != nullptr) {
+            char* aligned_ptr = align_pointer(cache.next, alignment);
+            if (aligned_ptr <= cache.chunk_end && required_size <= static_cast<std::size_t>(cache.chunk_end - aligned_ptr)) {
+                cache.next = aligned_ptr + required_size;
+                cache.allocation_count++;
+                return reinterpret_cast<T*>(aligned_ptr);
+            }
+        }
+
+        return reinterpret_cast<T*>(alloc_slow(cache, required_size, alignment));
+    }
+
+    // Function to deallocate memory from the calling thread.
+    // When the thread has freed everything it allocated, its current chunk is
+    // rewound and reused; the chunk itself stays cached until reset().
+    void dealloc() {
+        Cache& cache = local_cache();
+
+        if (cache.allocation_count > 0) {
+            cache.allocation_count--; // Decrease the thread's allocation count
+        }
+
+        if (cache.allocation_count == 0) {
+            cache.next = cache.chunk_start; // Rewind the thread's chunk
+        }
+    }
+
+    // Function to return every chunk to the parent.
+    // Must not run concurrently with alloc()/dealloc() on other threads.
+    void reset() {
+        std::lock_guard<std::mutex> guard(registry_mutex);
+
+        for (auto& cache : caches) {
+            cache->chunk_start = nullptr;
+            cache->next = nullptr;
+            cache->chunk_end = nullptr;
+            cache->allocation_count = 0;
+        }
+
+        // Each chunk counts as one allocation in the parent
+        std::size_t chunks = chunks_acquired.exchange(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < chunks; ++i) {
+            parent.dealloc();
+        }
+    }
+
+    // Function to get the number of chunks currently held from the parent
+    std::size_t chunk_count() const {
+        return chunks_acquired.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Per-thread bump state, padded to its own cache line(s) to avoid false sharing
+    struct alignas(64) Cache {
+        char* chunk_start = nullptr;      // Start of the thread's current chunk
+        char* next = nullptr;             // Bump pointer inside the chunk
+        char* chunk_end = nullptr;        // End of the thread's current chunk
+        std::size_t allocation_count = 0; // Active allocations made by this thread
+    };
+
+    Parent& parent;                               // Shared allocator the chunks come from
+    std::size_t chunk_size;                       // Size of each chunk taken from the parent
+    std::uint64_t id;                             // Unique id used to find this allocator's thread caches
+    std::atomic<std::size_t> chunks_acquired;     // Chunks handed out by the parent since the last reset
+    std::mutex registry_mutex;                    // Guards caches (slow path only)
+    std::vector<std::unique_ptr<Cache>> caches;   // Every thread cache created for this allocator
+    std::unordered_map<std::thread::id, Cache*> lookup; // Cache of each thread, guarded by registry_mutex
+
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Function to find (or create) the calling thread's cache for this allocator.
+    // The lookup lives in the allocator, so it dies with it; each thread only remembers
+    // the allocator it used last, by id, and ids are never reused.
+    // A new thread that gets a finished thread's id takes over its cache.
+    Cache& local_cache() {
+        struct LastUsed {
+            std::uint64_t id = 0;
+            Cache* cache = nullptr;
+        };
+        thread_local LastUsed last_used;
+
+        if (last_used.id == id) {
+            return *last_used.cache;
+        }
+
+        Cache* cache;
+        {
+            std::lock_guard<std::mutex> guard(registry_mutex);
+            Cache*& entry = lookup[std::this_thread::get_id()];
+            if (entry == nullptr) {
+                caches.push_back(std::unique_ptr<Cache>(new Cache()));
+                entry = caches.back().get();
+            }
+            cache = entry;
+        }
+
+        last_used.id = id;
+        last_used.cache = cache;
+        return *cache;
+    }
+
+    // Slow path: fetch a new chunk from the parent
+    char* alloc_slow(Cache& cache, std::size_t required_size, std::size_t alignment) {
+        std::size_t request = required_size + alignment;
+        bool dedicated = request > chunk_size / 2; // Big requests get their own chunk
+        if (!dedicated) {
+            request = chunk_size;
+        }
+
+        std::size_t units = (request + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        char* chunk = reinterpret_cast<char*>(parent.template alloc<std::max_align_t>(units));
+        if (chunk == nullptr) {
+            return nullptr; // Parent is out of memory
+        }
+        chunks_acquired.fetch_add(1, std::memory_order_relaxed);
+
+        char* chunk_end = chunk + units * sizeof(std::max_align_t);
+        char* aligned_ptr = align_pointer(chunk, alignment);
+        cache.allocation_count++;
+
+        if (!dedicated) {
+            // Retire the old chunk (it stays with the parent until reset) and bump from the new one
+            cache.chunk_start = chunk;
+            cache.chunk_end = chunk_end;
+            cache.next = aligned_ptr + required_size;
+        }
+        return aligned_ptr;
+    }
+
+    // Function to align a pointer to the required alignment
+    static char* align_pointer(char* ptr, std::size_t alignment) {
+        std::size_t mask = alignment - 1;                   // Create alignment mask
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & mask; // Calculate misalignment
+        if (misalignment != 0) {
+            ptr += (alignment - misalignment); // Adjust the pointer forward to align
+        }
+        return ptr; // Return aligned pointer
+    }
+};
+
+#endif // THREADCACHEDBUMPALLOCATOR_HPP
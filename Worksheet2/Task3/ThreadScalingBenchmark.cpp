@@ -0,0 +1,411 @@
+#include "BumpAllocatorUpwards.hpp"
+#include "BumpAllocatorAtomic.hpp"
+#include "ThreadCachedBumpAllocator.hpp"
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// Each thread makes at least this many allocations per measurement, so thread start-up and
+// join do not dominate short workloads, unless that would push its heap past max_bytes_per_thread.
+constexpr std::size_t min_allocations_per_thread = 100000;
+constexpr std::size_t max_bytes_per_thread = 16 * 1024 * 1024;
+constexpr std::size_t min_rounds_per_thread = 200;
+
+// Number of times each configuration is measured; the table reports the median.
+constexpr int repetitions = 5;
+
+//Workloads: the same allocation patterns as main.cpp, without the dealloc so every round keeps allocating.
+struct SmallWorkload {
+    static constexpr const char* name = "small";
+    static constexpr std::size_t allocations = 1000;
+    static constexpr std::size_t bytes = 1000 * sizeof(int);
+    template <typename Allocator>
+    static void round(Allocator& allocator) {
+        for (int i = 0; i < 1000; ++i) {
+            allocator.template alloc<int>(1);  // Allocate memory for one integer 1000 times.
+        }
+    }
+};
+
+struct LargeWorkload {
+    static constexpr const char* name = "large";
+    static constexpr std::size_t allocations = 10;
+    static constexpr std::size_t bytes = 10 * 100 * sizeof(int);
+    template <typename Allocator>
+    static void round(Allocator& allocator) {
+        for (int i = 0; i < 10; ++i) {
+            allocator.template alloc<int>(100);  // Allocate memory for 100 integers 10 times.
+        }
+    }
+};
+
+struct MixedWorkload {
+    static constexpr const char* name = "mixed";
+    static constexpr std::size_t allocations = 505;
+    static constexpr std::size_t bytes = (500 + 5 * 200) * sizeof(int);
+    template <typename Allocator>
+    static void round(Allocator& allocator) {
+        for (int i = 0; i < 500; ++i) {
+            allocator.template alloc<int>(1);  // Small allocations: 500 integers.
+        }
+        for (int i = 0; i < 5; ++i) {
+            allocator.template alloc<int>(200);  // Large allocations: 5 blocks of 200 integers.
+        }
+    }
+};
+
+struct CustomWorkload {
+    static constexpr const char* name = "custom_tests";
+    static constexpr std::size_t allocations = 3;
+    static constexpr std::size_t bytes = 50 * sizeof(int) + 20 * sizeof(double) + 100 * sizeof(float);
+    template <typename Allocator>
+    static void round(Allocator& allocator) {
+        allocator.template alloc<int>(50);    // Allocate memory for 50 integers.
+        allocator.template alloc<double>(20); // Allocate memory for 20 doubles.
+        allocator.template alloc<float>(100); // Allocate memory for 100 floats.
+    }
+};
+
+// Heap one round of Workload needs, with room for alignment padding.
+template <typename Workload>
+constexpr std::size_t bytes_per_round() {
+    return Workload::bytes + Workload::allocations * alignof(std::max_align_t);
+}
+
+// Number of workload rounds each thread runs per measurement.
+template <typename Workload>
+constexpr std::size_t rounds_per_thread() {
+    return std::max(min_rounds_per_thread,
+                    std::min(min_allocations_per_thread / Workload::allocations, max_bytes_per_thread / bytes_per_round<Workload>()));
+}
+
+// Heap one thread needs for a whole measurement.
+template <typename Workload>
+std::size_t bytes_per_thread() {
+    return rounds_per_thread<Workload>() * bytes_per_round<Workload>();
+}
+
+//Baselines: adapters giving malloc, new and std::pmr::monotonic_buffer_resource the alloc<T>(n) interface.
+//malloc and new remember their blocks so they can be freed outside the timed region; the block
+//list is reserved up front so growing it is not timed either.
+template <typename Workload>
+struct MallocAdapter {
+    explicit MallocAdapter(std::size_t) {
+        blocks.reserve(rounds_per_thread<Workload>() * Workload::allocations);
+    }
+    ~MallocAdapter() {
+        for (void* block : blocks) {
+            std::free(block);
+        }
+    }
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        void* block = std::malloc(sizeof(T) * num_objects);
+        blocks.push_back(block);
+        return static_cast<T*>(block);
+    }
+    std::vector<void*> blocks;
+};
+
+template <typename Workload>
+struct NewAdapter {
+    explicit NewAdapter(std::size_t) {
+        blocks.reserve(rounds_per_thread<Workload>() * Workload::allocations);
+    }
+    ~NewAdapter() {
+        for (void* block : blocks) {
+            ::operator delete(block);
+        }
+    }
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        void* block = ::operator new(sizeof(T) * num_objects);
+        blocks.push_back(block);
+        return static_cast<T*>(block);
+    }
+    std::vector<void*> blocks;
+};
+
+struct MonotonicAdapter {
+    explicit MonotonicAdapter(std::size_t bytes) : resource(bytes) {}
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        return static_cast<T*>(resource.allocate(sizeof(T) * num_objects, alignof(T)));
+    }
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+//monotonic_buffer_resource is not thread-safe, so sharing it needs a lock.
+struct LockedMonotonicAdapter {
+    explicit LockedMonotonicAdapter(std::size_t bytes) : resource(bytes) {}
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        std::lock_guard<std::mutex> guard(mutex);
+        return static_cast<T*>(resource.allocate(sizeof(T) * num_objects, alignof(T)));
+    }
+    std::pmr::monotonic_buffer_resource resource;
+    std::mutex mutex;
+};
+
+using NoLockBumpAllocator = BasicBumpAllocator<Upwards, NoLock, NoStats, NewHeap>;
+
+//Run Workload on one thread per entry of handles (entries may share an allocator) and return the
+//wall time in ms. A start barrier keeps thread creation out of the measurement.
+template <typename Workload, typename Allocator>
+double run_threads(const std::vector<Allocator*>& handles) {
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    workers.reserve(handles.size());
+    for (Allocator* handle : handles) {
+        workers.emplace_back([handle, &ready, &go] {
+            ready++;
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t r = 0; r < rounds_per_thread<Workload>(); ++r) {
+                Workload::round(*handle);
+            }
+        });
+    }
+    while (ready.load() != handles.size()) {
+        std::this_thread::yield();
+    }
+    double time_ms = Benchmark::measure_time_ms([&] {
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    });
+    return time_ms;
+}
+
+//Contended configuration: every thread allocates from one shared allocator.
+template <typename Workload, typename Allocator>
+double contended(unsigned thread_count) {
+    Allocator allocator(thread_count * bytes_per_thread<Workload>());
+    std::vector<Allocator*> handles(thread_count, &allocator);
+    return run_threads<Workload>(handles);
+}
+
+//Per-thread configuration: every thread has its own allocator (an arena per thread).
+template <typename Workload, typename Allocator>
+double per_thread(unsigned thread_count) {
+    std::vector<std::unique_ptr<Allocator>> allocators;
+    std::vector<Allocator*> handles;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        allocators.emplace_back(new Allocator(bytes_per_thread<Workload>()));
+        handles.push_back(allocators.back().get());
+    }
+    return run_threads<Workload>(handles);
+}
+
+//Thread-cached configuration: one ThreadCachedBumpAllocator over a lock-free parent.
+template <typename Workload>
+double thread_cached(unsigned thread_count) {
+    const std::size_t chunk_size = 64 * 1024;
+    BumpAllocatorAtomic parent(thread_count * (bytes_per_thread<Workload>() + 2 * chunk_size));
+    ThreadCachedBumpAllocator<BumpAllocatorAtomic> allocator(parent, chunk_size);
+    std::vector<ThreadCachedBumpAllocator<BumpAllocatorAtomic>*> handles(thread_count, &allocator);
+    double time_ms = run_threads<Workload>(handles);
+    allocator.reset(); // Return every chunk to the parent outside the timed region
+    return time_ms;
+}
+
+//Latency mode: wraps one thread's handle and times every alloc into that thread's own histogram.
+template <typename Allocator>
+struct TimedAllocator {
+    template <typename T>
+    T* alloc(std::size_t num_objects) {
+        return timer->time(histogram, [&] { return allocator->template alloc<T>(num_objects); });
+    }
+    Allocator* allocator;
+    const Benchmark::LatencyTimer* timer;
+    LatencyHistogram histogram;
+};
+
+//Run Workload through TimedAllocators over handles and merge the per-thread histograms.
+template <typename Workload, typename Allocator>
+LatencyHistogram timed_threads(const std::vector<Allocator*>& handles, const Benchmark::LatencyTimer& timer) {
+    std::vector<std::unique_ptr<TimedAllocator<Allocator>>> timed;
+    std::vector<TimedAllocator<Allocator>*> timed_handles;
+    for (Allocator* handle : handles) {
+        timed.emplace_back(new TimedAllocator<Allocator>{handle, &timer, LatencyHistogram()});
+        timed_handles.push_back(timed.back().get());
+    }
+    run_threads<Workload>(timed_handles);
+    LatencyHistogram merged;
+    for (const auto& handle : timed) {
+        merged.merge(handle->histogram);
+    }
+    return merged;
+}
+
+template <typename Workload, typename Allocator>
+LatencyHistogram contended_latency(unsigned thread_count, const Benchmark::LatencyTimer& timer) {
+    Allocator allocator(thread_count * bytes_per_thread<Workload>());
+    return timed_threads<Workload>(std::vector<Allocator*>(thread_count, &allocator), timer);
+}
+
+template <typename Workload, typename Allocator>
+LatencyHistogram per_thread_latency(unsigned thread_count, const Benchmark::LatencyTimer& timer) {
+    std::vector<std::unique_ptr<Allocator>> allocators;
+    std::vector<Allocator*> handles;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        allocators.emplace_back(new Allocator(bytes_per_thread<Workload>()));
+        handles.push_back(allocators.back().get());
+    }
+    return timed_threads<Workload>(handles, timer);
+}
+
+template <typename Workload>
+LatencyHistogram thread_cached_latency(unsigned thread_count, const Benchmark::LatencyTimer& timer) {
+    const std::size_t chunk_size = 64 * 1024;
+    BumpAllocatorAtomic parent(thread_count * (bytes_per_thread<Workload>() + 2 * chunk_size));
+    ThreadCachedBumpAllocator<BumpAllocatorAtomic> allocator(parent, chunk_size);
+    LatencyHistogram merged = timed_threads<Workload>(
+        std::vector<ThreadCachedBumpAllocator<BumpAllocatorAtomic>*>(thread_count, &allocator), timer);
+    allocator.reset();
+    return merged;
+}
+
+//Print per-call alloc latency percentiles for every config at the largest thread count.
+template <typename Workload>
+void run_latency(unsigned threads) {
+    struct LatencyConfig {
+        const char* name;
+        LatencyHistogram (*run)(unsigned thread_count, const Benchmark::LatencyTimer& timer);
+    };
+    const LatencyConfig configs[] = {
+        {"Mutex bump, contended", contended_latency<Workload, BumpAllocatorUpwards>},
+        {"Lock-free bump, contended", contended_latency<Workload, BumpAllocatorAtomic>},
+        {"Thread-cached bump", thread_cached_latency<Workload>},
+        {"Mutex bump, per-thread", per_thread_latency<Workload, BumpAllocatorUpwards>},
+        {"pmr monotonic + mutex, contended", contended_latency<Workload, LockedMonotonicAdapter>},
+        {"malloc", per_thread_latency<Workload, MallocAdapter<Workload>>},
+    };
+    Benchmark::LatencyTimer timer;
+
+    std::cout << "Workload: " << Workload::name << ", " << threads << " threads, alloc latency in ns (timer overhead of "
+              << timer.overhead_per_call() << " ns subtracted)\n";
+    std::cout << std::left << std::setw(36) << "Configuration" << std::right;
+    for (const char* column : {"p50", "p90", "p99", "p99.9", "p99.99", "max"}) {
+        std::cout << std::setw(10) << column;
+    }
+    std::cout << "\n";
+    for (const LatencyConfig& config : configs) {
+        LatencyHistogram histogram = config.run(threads, timer);
+        std::cout << std::left << std::setw(36) << config.name << std::right;
+        for (double percent : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+            std::cout << std::setw(10) << histogram.percentile(percent);
+        }
+        std::cout << std::setw(10) << histogram.max() << "\n";
+    }
+    std::cout << "\n";
+}
+
+//One configuration in the table: its name and how to run it at a given thread count.
+struct Config {
+    const char* name;
+    double (*run)(unsigned thread_count);
+};
+
+//Measure one configuration repetitions times and return the median wall time in ms.
+double median_time_ms(const Config& config, unsigned thread_count) {
+    std::vector<double> times;
+    for (int i = 0; i < repetitions; ++i) {
+        times.push_back(config.run(thread_count));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+//Print ops/sec and scaling efficiency (ops/sec at t threads over t times ops/sec at 1 thread) for every config.
+template <typename Workload>
+void run_workload(const std::vector<unsigned>& thread_counts) {
+    const Config configs[] = {
+        {"Mutex bump, contended", contended<Workload, BumpAllocatorUpwards>},
+        {"Lock-free bump, contended", contended<Workload, BumpAllocatorAtomic>},
+        {"Thread-cached bump", thread_cached<Workload>},
+        {"Mutex bump, per-thread", per_thread<Workload, BumpAllocatorUpwards>},
+        {"NoLock bump, per-thread", per_thread<Workload, NoLockBumpAllocator>},
+        {"pmr monotonic + mutex, contended", contended<Workload, LockedMonotonicAdapter>},
+        {"pmr monotonic, per-thread", per_thread<Workload, MonotonicAdapter>},
+        {"malloc", per_thread<Workload, MallocAdapter<Workload>>},
+        {"new", per_thread<Workload, NewAdapter<Workload>>},
+    };
+
+    std::cout << "Workload: " << Workload::name << " (" << rounds_per_thread<Workload>() << " rounds, "
+              << rounds_per_thread<Workload>() * Workload::allocations << " allocations per thread, median of "
+              << repetitions << " runs)\n";
+    std::cout << std::left << std::setw(36) << "Configuration" << std::right << std::setw(9) << "Threads"
+              << std::setw(12) << "ms" << std::setw(12) << "Mops/s" << std::setw(13) << "Efficiency\n";
+    for (const Config& config : configs) {
+        double single_thread_ops = 0;
+        for (unsigned threads : thread_counts) {
+            double time_ms = median_time_ms(config, threads);
+            double ops_per_sec = (threads * rounds_per_thread<Workload>() * Workload::allocations) / (time_ms / 1000.0);
+            if (threads == thread_counts.front()) {
+                single_thread_ops = ops_per_sec / threads;
+            }
+            double efficiency = ops_per_sec / (threads * single_thread_ops);
+            std::cout << std::left << std::setw(36) << config.name << std::right << std::setw(9) << threads
+                      << std::setw(12) << std::fixed << std::setprecision(2) << time_ms
+                      << std::setw(12) << ops_per_sec / 1e6
+                      << std::setw(11) << std::setprecision(0) << efficiency * 100 << " %\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char** argv) {
+    //--latency anywhere switches to per-call latency percentiles; the other arguments keep their positions.
+    bool latency = false;
+    std::vector<const char*> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--latency") == 0) {
+            latency = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    //Sweep 1, 2, 4 ... up to the hardware thread count (or the value given on the command line).
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (args.size() > 0) {
+        max_threads = std::max(1, std::atoi(args[0]));
+    }
+    const char* only = args.size() > 1 ? args[1] : nullptr; // Optional workload name to run alone
+
+    if (latency) {
+        if (!only || std::strcmp(only, SmallWorkload::name) == 0) run_latency<SmallWorkload>(max_threads);
+        if (!only || std::strcmp(only, LargeWorkload::name) == 0) run_latency<LargeWorkload>(max_threads);
+        if (!only || std::strcmp(only, MixedWorkload::name) == 0) run_latency<MixedWorkload>(max_threads);
+        if (!only || std::strcmp(only, CustomWorkload::name) == 0) run_latency<CustomWorkload>(max_threads);
+        return 0;
+    }
+
+    std::vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) {
+        thread_counts.push_back(t);
+    }
+    thread_counts.push_back(max_threads);
+
+    if (!only || std::strcmp(only, SmallWorkload::name) == 0) run_workload<SmallWorkload>(thread_counts);
+    if (!only || std::strcmp(only, LargeWorkload::name) == 0) run_workload<LargeWorkload>(thread_counts);
+    if (!only || std::strcmp(only, MixedWorkload::name) == 0) run_workload<MixedWorkload>(thread_counts);
+    if (!only || std::strcmp(only, CustomWorkload::name) == 0) run_workload<CustomWorkload>(thread_counts);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "BumpAllocatorUpwards.hpp"
+#include "BumpAllocatorDownwards.hpp"
+#include "AllocationTrace.hpp"
+#include "Benchmark.hpp"
+#include "MallocArena.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//Replays a recorded allocation trace against the bump allocators and malloc.
+//Usage: TraceReplay [trace file]. Without a file it records demo.trace from a sample workload first.
+
+//Sample workload for the demo trace: a server handling requests, each with a parse buffer, a few
+//header strings and a response, released by a rollback, plus a long-lived cache that grows slowly.
+template <typename Allocator>
+void record_demo(Allocator& allocator) {
+    std::srand(7);
+    for (int request = 0; request < 2000; ++request) {
+        auto start = allocator.mark();
+        allocator.alloc_bytes(4096, 64, "parse_buffer");
+        int headers = 4 + std::rand() % 12;
+        for (int h = 0; h < headers; ++h) {
+            allocator.alloc_bytes(16 + std::rand() % 112, 8, "header");
+        }
+        allocator.alloc_bytes(256 + std::rand() % 8192, 16, "response");
+        allocator.rollback(start);
+        if (request % 50 == 0) {
+            allocator.alloc_bytes(1024, 8, "cache_entry"); // Survives the request
+        }
+    }
+    for (int i = 0; i < 2000 / 50; ++i) {
+        allocator.dealloc(); // Drop the cache; the last dealloc resets the allocator
+    }
+}
+
+template <typename Allocator>
+void replay(const TraceReplayer& replayer, Allocator& allocator) {
+    Benchmark::do_not_optimize(replayer.run(allocator));
+}
+
+template <typename Allocator>
+void report(const char* name, const TraceReplayer& replayer, std::size_t heap_size) {
+    Allocator allocator(heap_size);
+    std::size_t succeeded = replayer.run(allocator);
+    Benchmark::Stats stats = Benchmark::run(replay<Allocator>, replayer, allocator);
+    Benchmark::print(std::cout, name, stats);
+    if (succeeded != replayer.allocations()) {
+        std::cout << "    " << replayer.allocations() - succeeded << " allocations failed\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "demo.trace";
+    if (argc <= 1) {
+        //Record the demo workload; the trace is written when the allocator is destroyed.
+        BasicBumpAllocatorUpwards<TraceRecorder> recorder(1024 * 1024, TraceRecorder(path));
+        record_demo(recorder);
+    }
+
+    Trace trace;
+    if (!read_trace(path, trace)) {
+        std::cerr << path << " is not a readable allocation trace\n";
+        return 1;
+    }
+    TraceReplayer replayer(trace);
+    std::size_t heap_size = trace.heap_size != 0 ? trace.heap_size : static_cast<std::size_t>(replayer.peak_bytes()) * 2;
+
+    std::cout << path << ": " << trace.records.size() << " events, " << replayer.allocations() << " allocations, "
+              << trace.tags.size() - 1 << " tags, peak " << replayer.peak_bytes() << " bytes live, heap "
+              << heap_size << " bytes\n";
+
+    using SingleThreadedAllocator = BasicBumpAllocator<Upwards, NoLock, NoStats, NewHeap>;
+    report<BumpAllocatorUpwards>("Replay - Up", replayer, heap_size);
+    report<BumpAllocatorDownwards>("Replay - Down", replayer, heap_size);
+    report<SingleThreadedAllocator>("Replay - NoLock", replayer, heap_size);
+    report<MallocArena>("Replay - malloc", replayer, heap_size);
+    return 0;
+}
@@ -0,0 +1,197 @@
+#ifndef WORKLOADGENERATOR_HPP
+#define WORKLOADGENERATOR_HPP
+
+#include <algorithm>  // For std::lower_bound, std::min and std::max
+#include <cmath>      // For std::log, std::exp, std::sqrt, std::cos and std::pow
+#include <cstddef>    // For size_t
+#include <cstdint>    // For uint64_t
+#include <random>     // For std::mt19937_64
+#include <stdexcept>  // For std::invalid_argument
+#include <vector>     // For the alignment mix and the Zipf table
+#include "AllocationTrace.hpp" // Generated streams are Traces, so TraceReplayer runs them
+
+// Seeded generator of synthetic allocation streams.
+//
+// Request sizes come from one of four distributions:
+//
+//   - uniform:    every size in [min_size, max_size] is equally likely
+//   - log_normal: sizes cluster around median_size with spread sigma, with a long right tail
+//   - zipf:       size k * min_size has probability proportional to 1 / k^zipf_exponent,
+//                 so a few small sizes dominate (typical of object-heavy code)
+//   - bimodal:    small_fraction of the requests are small (up to small_max), the
+//                 rest large (from large_min), as with headers and payload buffers
+//
+// Each request picks an alignment from the alignments list, and its size is
+// rounded up to a multiple of it, as sizeof(T) * n is for alignof(T). Every
+// reset_every requests the stream rolls back to empty.
+//
+// Only the 64-bit Mersenne Twister comes from <random>, because its output is
+// fixed by the standard. The distributions are computed here rather than with
+// the std::*_distribution classes, whose results are left to the library. For
+// uniform and bimodal this makes the same seed give the same stream with every
+// compiler and standard library, since they only scale the engine's bits by
+// exact IEEE arithmetic. log_normal and zipf also call std::log, std::exp,
+// std::cos and std::pow, whose last bits may differ between math libraries,
+// so their streams are only reproducible with the same library.
+//
+// The constructor throws std::invalid_argument for inconsistent parameters,
+// e.g. a bimodal large_min above max_size.
+enum class SizeDistribution { uniform, log_normal, zipf, bimodal };
+
+// Parameters of a generated workload
+struct WorkloadParams {
+    SizeDistribution distribution = SizeDistribution::uniform;
+    std::size_t min_size = 1;         // Smallest request (also the Zipf size step)
+    std::size_t max_size = 1024;      // Largest request; log-normal sizes are clamped to [min_size, max_size]
+    double median_size = 64;          // log_normal: median request
+    double sigma = 1.0;               // log_normal: standard deviation of log(size)
+    double zipf_exponent = 1.1;       // zipf: larger exponents favor small sizes more
+    double small_fraction = 0.9;      // bimodal: share of small requests
+    std::size_t small_max = 64;       // bimodal: small requests are in [min_size, small_max]
+    std::size_t large_min = 512;      // bimodal: large requests are in [large_min, max_size]
+    std::vector<std::size_t> alignments = {8}; // Power-of-two alignments, picked uniformly per request
+    std::size_t reset_every = 1000;   // Requests between rollbacks to empty (0 for never)
+    std::uint64_t seed = 1;           // Same seed and parameters give the same stream
+};
+
+// One generated request
+struct AllocationRequest {
+    std::size_t size;       // Bytes, a multiple of alignment
+    std::size_t alignment;  // Power of two
+};
+
+class WorkloadGenerator {
+public:
+    // Constructor: Seeds the generator and precomputes the Zipf table
+    explicit WorkloadGenerator(const WorkloadParams& params) : params(params), engine(params.seed) {
+        validate(params);
+        if (params.distribution == SizeDistribution::zipf) {
+            std::size_t ranks = std::max<std::size_t>(1, params.max_size / std::max<std::size_t>(1, params.min_size));
+            double total = 0;
+            zipf_cdf.reserve(ranks);
+            for (std::size_t k = 1; k <= ranks; ++k) {
+                total += 1.0 / std::pow(static_cast<double>(k), params.zipf_exponent);
+                zipf_cdf.push_back(total);
+            }
+            for (double& c : zipf_cdf) {
+                c /= total;
+            }
+        }
+    }
+
+    // Function to draw the next request
+    AllocationRequest next() {
+        std::size_t alignment = params.alignments.empty() ? 1 : params.alignments[uniform_index(params.alignments.size())];
+        std::size_t size = draw_size();
+        size = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+        return AllocationRequest{size, alignment};
+    }
+
+    // Function to generate count requests as a trace, with a rollback to empty every reset_every requests
+    Trace trace(std::size_t count) {
+        Trace result;
+        result.tags.push_back(std::string());
+        result.records.reserve(count + (params.reset_every ? count / params.reset_every : 0) + 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (params.reset_every != 0 && i != 0 && i % params.reset_every == 0) {
+                result.records.push_back(record(TraceRecord::rollback, 0, 0));
+            }
+            AllocationRequest request = next();
+            std::uint8_t alignment_log2 = 0;
+            while ((std::size_t(1) << alignment_log2) < request.alignment) {
+                alignment_log2++;
+            }
+            result.records.push_back(record(TraceRecord::alloc, request.size, alignment_log2));
+        }
+        result.records.push_back(record(TraceRecord::rollback, 0, 0));
+        return result;
+    }
+
+    // Function to get the name of a distribution (for reports)
+    static const char* name(SizeDistribution distribution) {
+        switch (distribution) {
+        case SizeDistribution::uniform: return "uniform";
+        case SizeDistribution::log_normal: return "log_normal";
+        case SizeDistribution::zipf: return "zipf";
+        case SizeDistribution::bimodal: return "bimodal";
+        }
+        return "unknown";
+    }
+
+    // Function to check that params describe a stream; throws std::invalid_argument if not
+    static void validate(const WorkloadParams& params) {
+        if (params.min_size > params.max_size) {
+            throw std::invalid_argument("WorkloadParams: min_size is above max_size");
+        }
+        for (std::size_t alignment : params.alignments) {
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+                throw std::invalid_argument("WorkloadParams: alignments must be powers of two");
+            }
+        }
+        if (params.distribution == SizeDistribution::log_normal && !(params.median_size > 0 && params.sigma >= 0)) {
+            throw std::invalid_argument("WorkloadParams: log_normal needs median_size > 0 and sigma >= 0");
+        }
+        if (params.distribution == SizeDistribution::bimodal &&
+            (!(params.small_fraction >= 0 && params.small_fraction <= 1) || params.small_max < params.min_size ||
+             params.large_min > params.max_size || params.small_max >= params.large_min)) {
+            throw std::invalid_argument("WorkloadParams: bimodal needs min_size <= small_max < large_min <= max_size "
+                                        "and small_fraction in [0, 1]");
+        }
+    }
+
+private:
+    WorkloadParams params;          // Parameters of the stream
+    std::mt19937_64 engine;         // Seeded source of random bits
+    std::vector<double> zipf_cdf;   // Cumulative Zipf probabilities by rank
+
+    // Function to get a uniform double in [0, 1) from 53 random bits
+    double uniform_real() {
+        return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Function to get a uniform index in [0, n)
+    std::size_t uniform_index(std::size_t n) {
+        return static_cast<std::size_t>(uniform_real() * static_cast<double>(n));
+    }
+
+    // Function to get a uniform size in [low, high]
+    std::size_t uniform_size(std::size_t low, std::size_t high) {
+        return high <= low ? low : low + uniform_index(high - low + 1);
+    }
+
+    std::size_t draw_size() {
+        switch (params.distribution) {
+        case SizeDistribution::uniform:
+            return uniform_size(params.min_size, params.max_size);
+        case SizeDistribution::log_normal: {
+            // Box-Muller transform for a standard normal value
+            double u1 = 1.0 - uniform_real(); // (0, 1], so the log is finite
+            double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * uniform_real());
+            double size = params.median_size * std::exp(params.sigma * z);
+            size = std::min(std::max(size, static_cast<double>(params.min_size)), static_cast<double>(params.max_size));
+            return static_cast<std::size_t>(size);
+        }
+        case SizeDistribution::zipf: {
+            std::size_t rank = std::lower_bound(zipf_cdf.begin(), zipf_cdf.end(), uniform_real()) - zipf_cdf.begin();
+            return (std::min(rank, zipf_cdf.size() - 1) + 1) * std::max<std::size_t>(1, params.min_size);
+        }
+        case SizeDistribution::bimodal:
+            return uniform_real() < params.small_fraction
+                ? uniform_size(params.min_size, params.small_max)
+                : uniform_size(params.large_min, params.max_size);
+        }
+        return params.min_size;
+    }
+
+    static TraceRecord record(TraceRecord::Kind kind, std::uint64_t value, std::uint8_t alignment_log2) {
+        TraceRecord result;
+        result.value = value;
+        result.delta_ns = 0;
+        result.tag = 0;
+        result.alignment_log2 = alignment_log2;
+        result.kind = kind;
+        return result;
+    }
+};
+
+#endif // WORKLOADGENERATOR_HPP
@@ -0,0 +1,193 @@
+#include "BumpAllocatorUpwards.hpp"
+#include "BumpAllocatorDownwards.hpp"
+#include "WorkloadGenerator.hpp"
+#include "MallocArena.hpp"
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//Sweeps generated workloads (size distribution, its parameter, alignment mix and reset frequency)
+//across the allocators and prints one row per measurement as CSV, or as JSON with --json.
+//Usage: WorkloadSweep [--json] [--requests N] [--seed S]
+
+using SingleThreadedAllocator = BasicBumpAllocator<Upwards, NoLock, NoStats, NewHeap>;
+
+//One point of the sweep.
+struct SweepPoint {
+    WorkloadParams params;
+    const char* parameter;   // Name of the swept parameter
+    double value;            // Its value
+    const char* alignments;  // Name of the alignment mix
+};
+
+//One measured row.
+struct SweepRow {
+    const SweepPoint* point;
+    const char* allocator;
+    double mean_size;
+    std::uint64_t peak_bytes;
+    Benchmark::Stats stats;      // Per request
+    std::size_t failed;
+};
+
+template <typename Allocator>
+void replay(const TraceReplayer& replayer, Allocator& allocator) {
+    Benchmark::do_not_optimize(replayer.run(allocator));
+}
+
+//Replay the workload on a fresh Allocator and convert the timings to per-request values.
+template <typename Allocator>
+SweepRow measure(const char* name, const SweepPoint& point, const TraceReplayer& replayer, double mean_size,
+                 const Benchmark::Options& options) {
+    std::size_t requests = replayer.allocations();
+    std::size_t max_alignment = 1;
+    for (std::size_t alignment : point.params.alignments) {
+        max_alignment = std::max(max_alignment, alignment);
+    }
+    std::size_t per_reset = point.params.reset_every != 0 ? std::min(point.params.reset_every, requests) : requests;
+    Allocator allocator(static_cast<std::size_t>(replayer.peak_bytes()) + per_reset * max_alignment); // Peak plus worst-case padding
+
+    SweepRow row{&point, name, mean_size, replayer.peak_bytes(), Benchmark::Stats(), requests - replayer.run(allocator)};
+    row.stats = Benchmark::run(options, replay<Allocator>, replayer, allocator);
+    for (double* value : {&row.stats.min, &row.stats.median, &row.stats.mean, &row.stats.p99, &row.stats.stddev}) {
+        *value /= static_cast<double>(requests);
+    }
+    return row;
+}
+
+//Build the sweep: three settings of each distribution's main parameter, two alignment mixes, two reset frequencies.
+std::vector<SweepPoint> sweep_points(std::uint64_t seed) {
+    struct Setting {
+        SizeDistribution distribution;
+        const char* parameter;
+        double values[3];
+    };
+    const Setting settings[] = {
+        {SizeDistribution::uniform, "max_size", {64, 1024, 16384}},
+        {SizeDistribution::log_normal, "median_size", {16, 256, 4096}},
+        {SizeDistribution::zipf, "zipf_exponent", {0.8, 1.1, 1.5}},
+        {SizeDistribution::bimodal, "small_fraction", {0.5, 0.9, 0.99}},
+    };
+    struct AlignmentMix {
+        const char* name;
+        std::vector<std::size_t> alignments;
+    };
+    const AlignmentMix mixes[] = {
+        {"8", {8}},
+        {"1/4/8/16/64", {1, 4, 8, 16, 64}},   // char, int, double, max_align_t and cache-line objects
+    };
+    const std::size_t resets[] = {100, 10000};
+
+    std::vector<SweepPoint> points;
+    for (const Setting& setting : settings) {
+        for (double value : setting.values) {
+            for (const AlignmentMix& mix : mixes) {
+                for (std::size_t reset_every : resets) {
+                    WorkloadParams params;
+                    params.distribution = setting.distribution;
+                    params.alignments = mix.alignments;
+                    params.reset_every = reset_every;
+                    params.seed = seed;
+                    switch (setting.distribution) {
+                    case SizeDistribution::uniform:
+                        params.max_size = static_cast<std::size_t>(value);
+                        break;
+                    case SizeDistribution::log_normal:
+                        params.median_size = value;
+                        params.max_size = 65536;
+                        break;
+                    case SizeDistribution::zipf:
+                        params.zipf_exponent = value;
+                        params.min_size = 8;
+                        params.max_size = 4096;
+                        break;
+                    case SizeDistribution::bimodal:
+                        params.small_fraction = value;
+                        params.large_min = 4096;
+                        params.max_size = 16384;
+                        break;
+                    }
+                    points.push_back(SweepPoint{params, setting.parameter, value, mix.name});
+                }
+            }
+        }
+    }
+    return points;
+}
+
+void print_csv(const std::vector<SweepRow>& rows) {
+    std::cout << "distribution,parameter,value,alignments,reset_every,allocator,mean_size,peak_bytes,"
+                 "median_ns,min_ns,p99_ns,failed\n";
+    for (const SweepRow& row : rows) {
+        const SweepPoint& point = *row.point;
+        std::cout << WorkloadGenerator::name(point.params.distribution) << "," << point.parameter << "," << point.value
+                  << "," << point.alignments << "," << point.params.reset_every << "," << row.allocator << ","
+                  << row.mean_size << "," << row.peak_bytes << "," << row.stats.median << "," << row.stats.min << ","
+                  << row.stats.p99 << "," << row.failed << "\n";
+    }
+}
+
+void print_json(const std::vector<SweepRow>& rows) {
+    std::cout << "[\n";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const SweepRow& row = rows[i];
+        const SweepPoint& point = *row.point;
+        std::cout << "  {\"distribution\": \"" << WorkloadGenerator::name(point.params.distribution)
+                  << "\", \"parameter\": \"" << point.parameter << "\", \"value\": " << point.value
+                  << ", \"alignments\": \"" << point.alignments << "\", \"reset_every\": " << point.params.reset_every
+                  << ", \"allocator\": \"" << row.allocator << "\", \"mean_size\": " << row.mean_size
+                  << ", \"peak_bytes\": " << row.peak_bytes << ", \"median_ns\": " << row.stats.median
+                  << ", \"min_ns\": " << row.stats.min << ", \"p99_ns\": " << row.stats.p99
+                  << ", \"failed\": " << row.failed << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+    }
+    std::cout << "]\n";
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    std::size_t requests = 10000;
+    std::uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+            requests = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+
+    //Fewer samples than main.cpp: the sweep has hundreds of rows.
+    Benchmark::Options options;
+    options.samples = 11;
+    options.min_sample_ns = 1e6;
+
+    std::vector<SweepPoint> points = sweep_points(seed);
+    std::vector<SweepRow> rows;
+    for (const SweepPoint& point : points) {
+        WorkloadGenerator generator(point.params);
+        Trace trace = generator.trace(requests);
+        TraceReplayer replayer(trace);
+        double total = 0;
+        for (const TraceRecord& record : trace.records) {
+            total += record.kind == TraceRecord::alloc ? static_cast<double>(record.value) : 0;
+        }
+        double mean_size = total / static_cast<double>(requests);
+
+        rows.push_back(measure<BumpAllocatorUpwards>("Up", point, replayer, mean_size, options));
+        rows.push_back(measure<BumpAllocatorDownwards>("Down", point, replayer, mean_size, options));
+        rows.push_back(measure<SingleThreadedAllocator>("NoLock", point, replayer, mean_size, options));
+        rows.push_back(measure<MallocArena>("malloc", point, replayer, mean_size, options));
+    }
+
+    if (json) {
+        print_json(rows);
+    } else {
+        print_csv(rows);
+    }
+    return 0;
+}
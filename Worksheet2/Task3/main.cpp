@@ -1,88 +1,464 @@
 #include "BumpAllocatorUpwards.hpp"
 #include "BumpAllocatorDownwards.hpp"
 #include "Benchmark.hpp"
+#include "BenchmarkResults.hpp"
+#include "MmapHeap.hpp"
+#include "ArenaBuffer.hpp"
+#include "ArenaSnapshot.hpp"
+#include "SharedBumpAllocator.hpp"
+#include "EpochArenaRing.hpp"
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
 
 //Add small allocation function for benchmarking small-sized memory allocations.
 template <typename Allocator>
 void small_allocations(Allocator& allocator) {
+    auto start = allocator.mark();  // Every call starts from the same heap state.
     for (int i = 0; i < 1000; ++i) {
-        allocator.template alloc<int>(1);  // Allocate memory for one integer 1000 times.
+        Benchmark::do_not_optimize(allocator.template alloc<int>(1));  // Allocate memory for one integer 1000 times.
     }
-    allocator.dealloc();  // Reset the allocator after allocations.
+    allocator.rollback(start);  // Reset the allocator after allocations.
+}
+
+//Add batched small allocations: the same 1000 integers as small_allocations, with one lock and one commit.
+template <typename Allocator>
+void batched_small_allocations(Allocator& allocator) {
+    auto start = allocator.mark();  // Every call starts from the same heap state.
+    typename Allocator::BatchRequest requests[1000];
+    void* results[1000];
+    for (int i = 0; i < 1000; ++i) {
+        requests[i] = {sizeof(int), alignof(int)};
+    }
+    allocator.alloc_batch(requests, 1000, results);
+    Benchmark::do_not_optimize(results);
+    allocator.rollback(start);  // Reset the allocator after allocations.
+}
+
+//Add struct-of-arrays setup: several related arrays allocated together in one batch.
+template <typename Allocator>
+void struct_of_arrays(Allocator& allocator) {
+    auto start = allocator.mark();  // Every call starts from the same heap state.
+    for (int i = 0; i < 100; ++i) {
+        Benchmark::do_not_optimize(allocator.template alloc_batch<int, double, float, char>(16, 16, 16, 16));
+    }
+    allocator.rollback(start);  // Reset the allocator after allocations.
 }
 
 //Add large allocation function to benchmark scenarios with larger memory blocks.
 template <typename Allocator>
 void large_allocations(Allocator& allocator) {
+    auto start = allocator.mark();  // Every call starts from the same heap state.
     for (int i = 0; i < 10; ++i) {
-        allocator.template alloc<int>(100);  // Allocate memory for 100 integers 10 times.
+        Benchmark::do_not_optimize(allocator.template alloc<int>(100));  // Allocate memory for 100 integers 10 times.
     }
-    allocator.dealloc();  // Reset the allocator after allocations.
+    allocator.rollback(start);  // Reset the allocator after allocations.
 }
 
 //Add mixed allocation function to test allocators with a combination of small and large allocations.
 template <typename Allocator>
 void mixed_allocations(Allocator& allocator) {
+    auto start = allocator.mark();  // Every call starts from the same heap state.
     for (int i = 0; i < 500; ++i) {
-        allocator.template alloc<int>(1);  // Small allocations: 500 integers.
+        Benchmark::do_not_optimize(allocator.template alloc<int>(1));  // Small allocations: 500 integers.
     }
     for (int i = 0; i < 5; ++i) {
-        allocator.template alloc<int>(200);  // Large allocations: 5 blocks of 200 integers.
+        Benchmark::do_not_optimize(allocator.template alloc<int>(200));  // Large allocations: 5 blocks of 200 integers.
     }
-    allocator.dealloc();  // Reset the allocator after allocations.
+    allocator.rollback(start);  // Reset the allocator after allocations.
 }
 
 //Add custom tests to simulate real-world allocation scenarios with multiple data types.
 template <typename Allocator>
 void custom_tests(Allocator& allocator) {
-    allocator.template alloc<int>(50);    // Allocate memory for 50 integers.
-    allocator.template alloc<double>(20); // Allocate memory for 20 doubles.
-    allocator.template alloc<float>(100); // Allocate memory for 100 floats.
+    auto start = allocator.mark();  // Every call starts from the same heap state.
+    Benchmark::do_not_optimize(allocator.template alloc<int>(50));    // Allocate memory for 50 integers.
+    Benchmark::do_not_optimize(allocator.template alloc<double>(20)); // Allocate memory for 20 doubles.
+    Benchmark::do_not_optimize(allocator.template alloc<float>(100)); // Allocate memory for 100 floats.
+    allocator.rollback(start);  // Reset the allocator after allocations.
+}
+
+//Add first-touch workload that writes every cache line of the heap, exposing page-fault and TLB costs.
+template <typename Allocator>
+void touch_heap(Allocator& allocator, std::size_t heap_size) {
+    const std::size_t block_size = 64 * 1024;
+    std::size_t blocks = heap_size / block_size;
+    for (std::size_t b = 0; b < blocks; ++b) {
+        char* block = allocator.template alloc<char>(block_size);
+        for (std::size_t i = 0; i < block_size; i += 64) {
+            block[i] = 1;  // Touch every cache line of the block.
+        }
+    }
+    for (std::size_t b = 0; b < blocks; ++b) {
+        allocator.dealloc();  // Reset the allocator after allocations.
+    }
+}
+
+//Add SIMD workload: axpy over cache-line-aligned float arrays, optionally shifted off alignment by offset floats.
+template <typename Allocator>
+void simd_axpy(Allocator& allocator, std::size_t offset) {
+    const std::size_t n = 256 * 1024;
+    float* x = allocator.template alloc<float, 64>(n + 16) + offset;  // 64-byte aligned (AVX-512 width) when offset is 0.
+    float* y = allocator.template alloc<float, 64>(n + 16) + offset;
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = 1.0f;
+        y[i] = 2.0f;
+    }
+    for (int pass = 0; pass < 20; ++pass) {
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = 0.5f * x[i] + y[i];  // Vectorized by the compiler at -O3.
+        }
+    }
+    Benchmark::do_not_optimize(y[n - 1]);
+    allocator.dealloc();  // Reset the allocator after allocations.
+    allocator.dealloc();
+}
+
+//Add false-sharing workload: two threads bump their own counter, either packed together or on isolated cache lines.
+template <typename Allocator>
+void per_thread_counters(Allocator& allocator, bool isolated) {
+    volatile long* counters[2];
+    for (auto& counter : counters) {
+        counter = allocator.template alloc_aligned<long>(1, alignof(long), isolated);
+        *counter = 0;
+    }
+    auto count = [](volatile long* counter) {
+        for (int i = 0; i < 10000000; ++i) {
+            *counter = *counter + 1;
+        }
+    };
+    std::thread first(count, counters[0]);
+    std::thread second(count, counters[1]);
+    first.join();
+    second.join();
+    allocator.dealloc();  // Reset the allocator after allocations.
+    allocator.dealloc();
+}
+
+//Add growable buffer workload: append 10000 integers to an arena buffer that grows in place.
+template <typename Allocator>
+void growable_buffer(Allocator& allocator) {
+    ArenaBuffer<int, Allocator> buffer(allocator);
+    for (int i = 0; i < 10000; ++i) {
+        buffer.push_back(i);
+    }
+    Benchmark::do_not_optimize(buffer.data());
     allocator.dealloc();  // Reset the allocator after allocations.
 }
 
-int main() {
+//Add the same appends to a std::vector, which copies on every capacity change.
+void vector_buffer() {
+    std::vector<int> buffer;
+    for (int i = 0; i < 10000; ++i) {
+        buffer.push_back(i);
+    }
+    Benchmark::do_not_optimize(buffer.data());
+}
+
+//Add lookup table node for the snapshot workload, linked with offset pointers so it survives a reload.
+struct LookupEntry {
+    long key;
+    long value;
+    offset_ptr<LookupEntry> next;
+};
+
+//Build a linked lookup table of count entries in the arena and return its head.
+template <typename Allocator>
+LookupEntry* build_lookup_table(Allocator& allocator, long count) {
+    LookupEntry* head = nullptr;
+    for (long i = count; i > 0; --i) {
+        head = allocator.template create<LookupEntry>(LookupEntry{i, i * i, head});
+    }
+    return head;
+}
+
+//Add cross-process workload: several forked workers allocate from one shared-memory arena at once.
+void shared_arena_workers(const char* name, int processes) {
+    std::vector<pid_t> children;
+    for (int p = 0; p < processes; ++p) {
+        pid_t child = fork();
+        if (child == 0) {
+            SharedBumpAllocator worker(name);  // Attach to the parent's segment.
+            for (int i = 0; i < 100000; ++i) {
+                worker.alloc<int>(1);
+            }
+            _exit(0);
+        }
+        children.push_back(child);
+    }
+    for (pid_t child : children) {
+        waitpid(child, nullptr, 0);
+    }
+}
+
+//Add epoch workload: rebuild a routing table in the next arena and publish it, as a periodic config reload would.
+template <typename Ring>
+void rebuild_routing_table(Ring& ring) {
+    long* table = ring.begin_update().template alloc<long>(1000);
+    for (long i = 0; i < 1000; ++i) {
+        table[i] = i;
+    }
+    ring.publish(table);
+}
+
+//Add epoch reader workload: pin the current epoch and read one entry, 100000 times.
+template <typename Ring>
+void pinned_reads(Ring& ring) {
+    long sum = 0;
+    for (int i = 0; i < 100000; ++i) {
+        auto guard = ring.pin();
+        sum += guard.template root<long>()[i % 1000];
+    }
+    Benchmark::do_not_optimize(sum);  // Keep the reads.
+}
+
+//Report setup, first-touch and warm times for one backing store.
+template <typename Factory>
+void first_touch_vs_warm(const char* name, std::size_t heap_size, Factory make_allocator) {
+    std::unique_ptr<BumpAllocatorUpwards> allocator;
+    double setup_ms = Benchmark::measure_time_ms([&] { allocator = make_allocator(); });
+    double first_ms = Benchmark::measure_time_ms(touch_heap<BumpAllocatorUpwards>, *allocator, heap_size);
+    double warm_ms = Benchmark::measure_time_ms(touch_heap<BumpAllocatorUpwards>, *allocator, heap_size);
+    std::cout << name << " - setup: " << setup_ms << " ms, first touch: " << first_ms
+              << " ms, warm: " << warm_ms << " ms\n";
+}
+
+//Add per-call latency workload: time every alloc and every dealloc of 200 rounds of 1000 integers.
+template <typename Allocator>
+void call_latencies(Allocator& allocator, const Benchmark::LatencyTimer& timer, LatencyHistogram& alloc_latency, LatencyHistogram& dealloc_latency) {
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            Benchmark::do_not_optimize(timer.time(alloc_latency, [&] { return allocator.template alloc<int>(1); }));
+        }
+        for (int i = 0; i < 1000; ++i) {
+            timer.time(dealloc_latency, [&] { allocator.dealloc(); });  // The last dealloc resets the allocator.
+        }
+    }
+}
+
+//Add contended latency workload: threads share one allocator, each records into its own histograms, merged at the end.
+template <typename Allocator>
+void contended_latencies(Allocator& allocator, const Benchmark::LatencyTimer& timer, int threads, LatencyHistogram& alloc_latency) {
+    std::vector<std::unique_ptr<LatencyHistogram>> per_thread;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        per_thread.emplace_back(new LatencyHistogram());
+        LatencyHistogram* histogram = per_thread.back().get();
+        workers.emplace_back([&allocator, &timer, histogram] {
+            for (int i = 0; i < 50000; ++i) {
+                Benchmark::do_not_optimize(timer.time(*histogram, [&] { return allocator.template alloc<int>(1); }));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& histogram : per_thread) {
+        alloc_latency.merge(*histogram);
+    }
+}
+
+//Benchmark options shared by every repeated measurement; --tsc times in CPU cycles, --perf adds hardware counters.
+Benchmark::Options bench_options;
+
+//Every repeated measurement of this run, saved with --save for a later --compare.
+ResultFile bench_results;
+
+//Print one measurement and keep it for the result file.
+void record(const char* name, const Benchmark::Stats& stats) {
+    Benchmark::print(std::cout, name, stats);
+    bench_results.results.push_back(BenchmarkResult{name, stats});
+}
+
+//Run one repeatable workload with warmup and calibrated repetitions and print its statistics.
+template <typename Allocator>
+void report(const char* name, void (*workload)(Allocator&), Allocator& allocator) {
+    record(name, Benchmark::run(bench_options, workload, allocator));
+}
+
+int main(int argc, char** argv) {
+    const char* save_path = nullptr;
+    const char* compare_paths[2] = {nullptr, nullptr};
+    double threshold_percent = 5;  // Smaller median changes are treated as noise.
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--tsc") {
+            bench_options.use_tsc = true;
+        }
+        if (std::string(argv[i]) == "--perf") {
+            bench_options.perf_counters = true;  // Hardware counters per call, if perf_event_open is allowed.
+        }
+        if (std::string(argv[i]) == "--save" && i + 1 < argc) {
+            save_path = argv[++i];  // Write every result with host and compiler metadata as JSON.
+        }
+        if (std::string(argv[i]) == "--compare" && i + 2 < argc) {
+            compare_paths[0] = argv[++i];
+            compare_paths[1] = argv[++i];
+        }
+        if (std::string(argv[i]) == "--threshold" && i + 1 < argc) {
+            threshold_percent = std::atof(argv[++i]);
+        }
+    }
+
+    //Compare mode: diff saved results instead of benchmarking; exit code 2 flags regressions.
+    //Each side may list several runs of the same build, separated by commas (old1.json,old2.json,...).
+    if (compare_paths[0] != nullptr) {
+        ResultFile old_run, new_run;
+        for (int f = 0; f < 2; ++f) {
+            if (!read_runs(compare_paths[f], f == 0 ? old_run : new_run)) {
+                std::cerr << compare_paths[f] << " is not a readable list of result files\n";
+                return 1;
+            }
+        }
+        return print_comparison(std::cout, old_run, new_run, threshold_percent) == 0 ? 0 : 2;
+    }
+    bench_results.metadata = collect_metadata();
+
     //Initialize upward and downward bump allocators with 1MB of memory.
     BumpAllocatorUpwards allocator_up(1024 * 1024);      // 1 MB Upward Allocator.
     BumpAllocatorDownwards allocator_down(1024 * 1024);  // 1 MB Downward Allocator.
 
     //Benchmark upward bump allocator for all test cases.
-    std::cout << "UpwardBumpAllocator:\n";
-    double up_time_ms = Benchmark::measure_time_ms(small_allocations<BumpAllocatorUpwards>, allocator_up);
-    double up_time_ns = Benchmark::measure_time_ns(small_allocations<BumpAllocatorUpwards>, allocator_up);
-    std::cout << "Small Allocations - Up: " << up_time_ms << " ms (" << up_time_ns << " ns)\n";
+    std::cout << "UpwardBumpAllocator (time per workload call):\n";
+    report("Small Allocations - Up", small_allocations<BumpAllocatorUpwards>, allocator_up);
+    report("Batched Small Allocations - Up", batched_small_allocations<BumpAllocatorUpwards>, allocator_up);
+    report("Struct of Arrays (batched) - Up", struct_of_arrays<BumpAllocatorUpwards>, allocator_up);
+    report("Large Allocations - Up", large_allocations<BumpAllocatorUpwards>, allocator_up);
+    report("Mixed Allocations - Up", mixed_allocations<BumpAllocatorUpwards>, allocator_up);
+    report("Custom Tests - Up", custom_tests<BumpAllocatorUpwards>, allocator_up);
 
-    up_time_ms = Benchmark::measure_time_ms(large_allocations<BumpAllocatorUpwards>, allocator_up);
-    up_time_ns = Benchmark::measure_time_ns(large_allocations<BumpAllocatorUpwards>, allocator_up);
-    std::cout << "Large Allocations - Up: " << up_time_ms << " ms (" << up_time_ns << " ns)\n";
+    //Benchmark downward bump allocator for all test cases.
+    std::cout << "\nDownwardBumpAllocator (time per workload call):\n";
+    report("Small Allocations - Down", small_allocations<BumpAllocatorDownwards>, allocator_down);
+    report("Batched Small Allocations - Down", batched_small_allocations<BumpAllocatorDownwards>, allocator_down);
+    report("Struct of Arrays (batched) - Down", struct_of_arrays<BumpAllocatorDownwards>, allocator_down);
+    report("Large Allocations - Down", large_allocations<BumpAllocatorDownwards>, allocator_down);
+    report("Mixed Allocations - Down", mixed_allocations<BumpAllocatorDownwards>, allocator_down);
+    report("Custom Tests - Down", custom_tests<BumpAllocatorDownwards>, allocator_down);
 
-    up_time_ms = Benchmark::measure_time_ms(mixed_allocations<BumpAllocatorUpwards>, allocator_up);
-    up_time_ns = Benchmark::measure_time_ns(mixed_allocations<BumpAllocatorUpwards>, allocator_up);
-    std::cout << "Mixed Allocations - Up: " << up_time_ms << " ms (" << up_time_ns << " ns)\n";
+    //Benchmark the single-threaded, uninstrumented specialization of the policy-based allocator.
+    using SingleThreadedAllocator = BasicBumpAllocator<Upwards, NoLock, NoStats, NewHeap>;
+    SingleThreadedAllocator allocator_st(1024 * 1024);  // 1 MB lock-free single-threaded allocator.
+    std::cout << "\nUpwards + NoLock + NoStats:\n";
+    report("Small Allocations - NoLock", small_allocations<SingleThreadedAllocator>, allocator_st);
+    report("Large Allocations - NoLock", large_allocations<SingleThreadedAllocator>, allocator_st);
+    report("Mixed Allocations - NoLock", mixed_allocations<SingleThreadedAllocator>, allocator_st);
+    report("Custom Tests - NoLock", custom_tests<SingleThreadedAllocator>, allocator_st);
 
-    up_time_ms = Benchmark::measure_time_ms(custom_tests<BumpAllocatorUpwards>, allocator_up);
-    up_time_ns = Benchmark::measure_time_ns(custom_tests<BumpAllocatorUpwards>, allocator_up);
-    std::cout << "Custom Tests - Up: " << up_time_ms << " ms (" << up_time_ns << " ns)\n";
+    //Compare backing stores: page faults on first touch versus a warm heap.
+    std::cout << "\nBacking store (64 MB heap, first touch vs warm):\n";
+    const std::size_t touch_size = 64 * 1024 * 1024;
+    first_touch_vs_warm("new char[]", touch_size, [&] {
+        return std::unique_ptr<BumpAllocatorUpwards>(new BumpAllocatorUpwards(touch_size));
+    });
+    first_touch_vs_warm("mmap", touch_size, [&] {
+        return std::unique_ptr<BumpAllocatorUpwards>(new BumpAllocatorUpwards(MmapHeap(touch_size)));
+    });
+    first_touch_vs_warm("mmap + prefault", touch_size, [&] {
+        MmapOptions options;
+        options.prefault = true;
+        return std::unique_ptr<BumpAllocatorUpwards>(new BumpAllocatorUpwards(MmapHeap(touch_size, options)));
+    });
+    first_touch_vs_warm("mmap + huge pages", touch_size, [&] {
+        MmapOptions options;
+        options.huge_pages = true;
+        return std::unique_ptr<BumpAllocatorUpwards>(new BumpAllocatorUpwards(MmapHeap(touch_size, options)));
+    });
 
-    //Benchmark downward bump allocator for all test cases.
-    std::cout << "\nDownwardBumpAllocator:\n";
-    double down_time_ms = Benchmark::measure_time_ms(small_allocations<BumpAllocatorDownwards>, allocator_down);
-    double down_time_ns = Benchmark::measure_time_ns(small_allocations<BumpAllocatorDownwards>, allocator_down);
-    std::cout << "Small Allocations - Down: " << down_time_ms << " ms (" << down_time_ns << " ns)\n";
+    //Compare a buffer that grows in place at the arena tail with std::vector.
+    std::cout << "\nGrowable buffer (10000 ints):\n";
+    report("ArenaBuffer - Up", growable_buffer<BumpAllocatorUpwards>, allocator_up);
+    report("ArenaBuffer - Down", growable_buffer<BumpAllocatorDownwards>, allocator_down);
+    record("std::vector", Benchmark::run(bench_options, vector_buffer));
+
+    //Compare rebuilding a lookup table at startup with mapping a saved snapshot of it.
+    std::cout << "\nSnapshot (100000-entry lookup table):\n";
+    const char* snapshot_path = "/tmp/task3_lookup_snapshot.bin";
+    {
+        BumpAllocatorUpwards allocator_table(8 * 1024 * 1024);
+        LookupEntry* table = nullptr;
+        double build_ms = Benchmark::measure_time_ms([&] { table = build_lookup_table(allocator_table, 100000); });
+        save_snapshot(allocator_table, table, snapshot_path);
+        std::cout << "Rebuild: " << build_ms << " ms\n";
+    }
+    double load_ms = Benchmark::measure_time_ms([&] { MappedSnapshot snapshot(snapshot_path, false); });
+    double verified_ms = Benchmark::measure_time_ms([&] { MappedSnapshot snapshot(snapshot_path); });
+    std::cout << "Map snapshot: " << load_ms << " ms, with checksum: " << verified_ms << " ms\n";
+    std::remove(snapshot_path);
+
+    //Run forked workers against one shared-memory arena instead of one heap per process.
+    std::cout << "\nShared-memory arena (100000 allocations per process):\n";
+    const char* shared_name = "/task3_shared_arena";
+    SharedBumpAllocator::remove(shared_name);
+    {
+        SharedBumpAllocator shared(shared_name, 16 * 1024 * 1024);  // 16 MB shared by every worker.
+        for (int processes = 1; processes <= 4; processes *= 2) {
+            //The workers' allocations stay in the arena (another process's rollback would fail), so report this row's share.
+            std::size_t live_before = shared.allocation_count();
+            double shared_ms = Benchmark::measure_time_ms(shared_arena_workers, shared_name, processes);
+            std::cout << processes << " process(es): " << shared_ms << " ms, "
+                      << shared.allocation_count() - live_before << " allocations added\n";
+        }
+    }
+    SharedBumpAllocator::remove(shared_name);
+
+    //Measure epoch-based reclamation: publishing a rebuilt table and pinning it from a reader.
+    std::cout << "\nEpoch arena ring (double-buffered 1000-entry table):\n";
+    EpochArenaRing<BumpAllocatorUpwards> ring(64 * 1024);
+    rebuild_routing_table(ring);
+    report("Rebuild and publish", rebuild_routing_table<EpochArenaRing<BumpAllocatorUpwards>>, ring);
+    report("100000 pinned reads", pinned_reads<EpochArenaRing<BumpAllocatorUpwards>>, ring);
 
-    down_time_ms = Benchmark::measure_time_ms(large_allocations<BumpAllocatorDownwards>, allocator_down);
-    down_time_ns = Benchmark::measure_time_ns(large_allocations<BumpAllocatorDownwards>, allocator_down);
-    std::cout << "Large Allocations - Down: " << down_time_ms << " ms (" << down_time_ns << " ns)\n";
+    //Compare aligned and misaligned vector loops, and packed versus cache-line-isolated per-thread counters.
+    BumpAllocatorUpwards allocator_simd(4 * 1024 * 1024);  // 4 MB for two 1 MB float arrays.
+    std::cout << "\nOver-alignment:\n";
+    record("SIMD axpy - 64-byte aligned", Benchmark::run(bench_options, simd_axpy<BumpAllocatorUpwards>, allocator_simd, 0));
+    record("SIMD axpy - misaligned by 4 bytes", Benchmark::run(bench_options, simd_axpy<BumpAllocatorUpwards>, allocator_simd, 1));
+    double packed_ms = Benchmark::measure_time_ms(per_thread_counters<BumpAllocatorUpwards>, allocator_simd, false);
+    double isolated_ms = Benchmark::measure_time_ms(per_thread_counters<BumpAllocatorUpwards>, allocator_simd, true);
+    std::cout << "Per-thread counters - packed (false sharing): " << packed_ms << " ms, isolated: " << isolated_ms << " ms\n";
 
-    down_time_ms = Benchmark::measure_time_ms(mixed_allocations<BumpAllocatorDownwards>, allocator_down);
-    down_time_ns = Benchmark::measure_time_ns(mixed_allocations<BumpAllocatorDownwards>, allocator_down);
-    std::cout << "Mixed Allocations - Down: " << down_time_ms << " ms (" << down_time_ns << " ns)\n";
+    //Record the latency of individual calls: averages hide the tail, and lock contention only shows up there.
+    Benchmark::LatencyTimer timer(bench_options.use_tsc);
+    std::cout << "\nPer-call latency (timer overhead of " << timer.overhead_per_call() << " " << timer.unit() << " subtracted):\n";
+    {
+        LatencyHistogram alloc_up, dealloc_up, alloc_down, dealloc_down, alloc_st, dealloc_st;
+        call_latencies(allocator_up, timer, alloc_up, dealloc_up);
+        call_latencies(allocator_down, timer, alloc_down, dealloc_down);
+        call_latencies(allocator_st, timer, alloc_st, dealloc_st);
+        alloc_up.print(std::cout, "alloc - Up", timer.unit());
+        dealloc_up.print(std::cout, "dealloc - Up", timer.unit());
+        alloc_down.print(std::cout, "alloc - Down", timer.unit());
+        dealloc_down.print(std::cout, "dealloc - Down", timer.unit());
+        alloc_st.print(std::cout, "alloc - NoLock", timer.unit());
+        dealloc_st.print(std::cout, "dealloc - NoLock", timer.unit());
 
-    down_time_ms = Benchmark::measure_time_ms(custom_tests<BumpAllocatorDownwards>, allocator_down);
-    down_time_ns = Benchmark::measure_time_ns(custom_tests<BumpAllocatorDownwards>, allocator_down);
-    std::cout << "Custom Tests - Down: " << down_time_ms << " ms (" << down_time_ns << " ns)\n";
+        BumpAllocatorUpwards allocator_shared(4 * 50000 * alignof(std::max_align_t));  // Room for 4 threads x 50000 ints.
+        LatencyHistogram alloc_shared;
+        contended_latencies(allocator_shared, timer, 4, alloc_shared);
+        alloc_shared.print(std::cout, "alloc - Up, 4 threads contended", timer.unit());
+    }
+
+    //Dump allocation statistics for the mixed workload so the arena can be sized from data.
+    BasicBumpAllocatorUpwards<AllocationStats> instrumented(1024 * 1024);
+    mixed_allocations(instrumented);
+    custom_tests(instrumented);
+    std::cout << "\nAllocation statistics (mixed + custom, upward allocator):\n";
+    instrumented.stats().to_json(std::cout);
+    std::cout << "\n";
 
     //Finalize benchmarking with performance results for both allocators.
+    if (save_path != nullptr) {
+        if (!write_results(save_path, bench_results)) {
+            std::cerr << "Could not write " << save_path << "\n";
+            return 1;
+        }
+        std::cout << "\nSaved " << bench_results.results.size() << " results to " << save_path << "\n";
+    }
     return 0;
 }